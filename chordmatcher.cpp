@@ -0,0 +1,150 @@
+#include "chordmatcher.h"
+#include <algorithm>
+#include <deque>
+#include <map>
+
+namespace {
+
+std::uint64_t edgeKey(std::int32_t node, ChordMatcher::Chord chord) {
+    return (std::uint64_t(std::uint32_t(node)) << 32) | chord;
+}
+
+// Fibonacci hashing spreads the packed (node, chord) keys across the table
+std::uint64_t hashKey(std::uint64_t key) {
+    key *= 0x9E3779B97F4A7C15ull;
+    return key ^ (key >> 29);
+}
+
+} // namespace
+
+ChordMatcher::ChordMatcher() {
+    clear();
+}
+
+void ChordMatcher::clear() {
+    m_sequences.clear();
+    rebuild();
+}
+
+bool ChordMatcher::isEmpty() const {
+    return m_sequences.empty();
+}
+
+std::int32_t ChordMatcher::find(std::int32_t node, Chord chord) const {
+    const std::uint64_t key = edgeKey(node, chord);
+    for (std::uint64_t i = hashKey(key) & m_mask;; i = (i + 1) & m_mask) {
+        const Edge& e = m_edges[i];
+        if (e.next < 0) return -1;
+        if (e.key == key) return e.next;
+    }
+}
+
+void ChordMatcher::insertEdge(std::uint64_t key, std::int32_t next) {
+    std::uint64_t i = hashKey(key) & m_mask;
+    while (m_edges[i].next >= 0) i = (i + 1) & m_mask;
+    m_edges[i] = Edge{key, next};
+}
+
+void ChordMatcher::grow() {
+    std::vector<Edge> old;
+    old.swap(m_edges);
+    m_edges.assign(old.size() * 2, Edge{0, -1});
+    m_mask = m_edges.size() - 1;
+    for (const Edge& e : old) {
+        if (e.next >= 0) insertEdge(e.key, e.next);
+    }
+}
+
+bool ChordMatcher::addSequence(const std::vector<Chord>& chords, int id) {
+    if (chords.empty() || id < 0) return false;
+
+    auto contains = [](const std::vector<Chord>& haystack, const std::vector<Chord>& needle) {
+        return std::search(haystack.begin(), haystack.end(), needle.begin(), needle.end()) != haystack.end();
+    };
+    for (const Sequence& s : m_sequences) {
+        if (contains(s.chords, chords) || contains(chords, s.chords)) return false;
+    }
+
+    m_sequences.push_back(Sequence{chords, id});
+    rebuild();
+    return true;
+}
+
+void ChordMatcher::rebuild() {
+    m_edges.assign(16, Edge{0, -1});
+    m_mask = m_edges.size() - 1;
+    m_edgeCount = 0;
+    m_nodeIds.assign(1, NoMatch);
+    m_state = 0;
+
+    // Plain trie first
+    std::vector<std::map<Chord, std::int32_t>> children(1);
+    for (const Sequence& s : m_sequences) {
+        std::int32_t node = 0;
+        for (Chord chord : s.chords) {
+            auto it = children[node].find(chord);
+            if (it == children[node].end()) {
+                const std::int32_t next = std::int32_t(m_nodeIds.size());
+                m_nodeIds.push_back(NoMatch);
+                children.emplace_back();
+                it = children[node].emplace(chord, next).first;
+            }
+            node = it->second;
+        }
+        m_nodeIds[node] = s.id;
+    }
+
+    // Breadth-first, so a node's failure link (the longest proper suffix of
+    // its path that is also a prefix) is complete before the node itself.
+    // A node moves like its failure node, except where it has own children.
+    std::vector<std::map<Chord, std::int32_t>> transitions(m_nodeIds.size());
+    std::vector<std::int32_t> failure(m_nodeIds.size(), 0);
+    std::deque<std::int32_t> queue;
+
+    transitions[0] = children[0];
+    for (const auto& [chord, child] : children[0]) queue.push_back(child);
+
+    while (!queue.empty()) {
+        const std::int32_t node = queue.front();
+        queue.pop_front();
+
+        transitions[node] = transitions[failure[node]];
+        for (const auto& [chord, child] : children[node]) {
+            transitions[node][chord] = child;
+
+            const auto& fallback = transitions[failure[node]];
+            auto it = fallback.find(chord);
+            failure[child] = (it == fallback.end()) ? 0 : it->second;
+            queue.push_back(child);
+        }
+    }
+
+    // Completed sequences reset to the root, so their moves are never needed.
+    // Neither are moves back to the root: a missing edge means exactly that.
+    for (std::size_t node = 0; node < transitions.size(); ++node) {
+        if (m_nodeIds[node] != NoMatch) continue;
+        for (const auto& [chord, next] : transitions[node]) {
+            if ((m_edgeCount + 1) * 2 > m_edges.size()) grow();
+            insertEdge(edgeKey(std::int32_t(node), chord), next);
+            ++m_edgeCount;
+        }
+    }
+}
+
+int ChordMatcher::feed(Chord chord, std::uint32_t timestampMs) {
+    if (m_timeoutMs && m_state != 0 && timestampMs - m_lastMs > m_timeoutMs) {
+        m_state = 0;
+    }
+    m_lastMs = timestampMs;
+
+    // Fallbacks for broken partial matches are precomputed: one probe
+    const std::int32_t next = find(m_state, chord);
+    if (next < 0) {
+        m_state = 0;
+        return NoMatch;
+    }
+
+    const int id = m_nodeIds[next];
+    m_state = (id != NoMatch) ? 0 : next;
+    return id;
+}
@@ -0,0 +1,66 @@
+#ifndef CHORDMATCHER_H
+#define CHORDMATCHER_H
+
+#include <cstdint>
+#include <vector>
+
+// Matches a stream of key chords against multi-chord sequences such as
+// "Ctrl+K, Ctrl+M". Sequences are compiled into an Aho-Corasick automaton:
+// every transition, including the fallbacks taken when a partial match
+// breaks, is precomputed into a flat open-addressed table. feed() is one
+// probe that never allocates - cheap enough for a low-level keyboard hook.
+class ChordMatcher {
+public:
+    using Chord = std::uint32_t;
+    static constexpr int NoMatch = -1;
+
+    // Packs a modifier mask and a key code into one chord value
+    static constexpr Chord makeChord(std::uint16_t modifiers, std::uint16_t key) {
+        return (Chord(modifiers) << 16) | key;
+    }
+
+    ChordMatcher();
+
+    // Returns false if the sequence is empty, or contains / is contained in
+    // an already added one (the shorter would always fire first). Rebuilds
+    // the automaton, so add sequences up front rather than while feeding.
+    bool addSequence(const std::vector<Chord>& chords, int id);
+    void clear();
+    bool isEmpty() const;
+
+    // Max gap between two chords of a sequence, 0 disables the timeout
+    void setChordTimeout(std::uint32_t ms) { m_timeoutMs = ms; }
+
+    // Feeds one key-down chord. Returns the id of the sequence it completed,
+    // or NoMatch. Not thread-safe: feed from one thread only.
+    int feed(Chord chord, std::uint32_t timestampMs = 0);
+    void reset() { m_state = 0; }
+
+private:
+    struct Sequence {
+        std::vector<Chord> chords;
+        int id;
+    };
+
+    struct Edge {
+        std::uint64_t key;  // (node << 32) | chord
+        std::int32_t next;  // < 0 marks an empty slot
+    };
+
+    std::vector<Sequence> m_sequences;
+    std::vector<Edge> m_edges;  // power-of-two sized, load factor <= 1/2; missing means "to root"
+    std::vector<int> m_nodeIds; // sequence completed at each node, [0] is the root
+    std::uint64_t m_mask = 0;
+    std::size_t m_edgeCount = 0;
+
+    std::int32_t m_state = 0;
+    std::uint32_t m_lastMs = 0;
+    std::uint32_t m_timeoutMs = 0;
+
+    std::int32_t find(std::int32_t node, Chord chord) const;
+    void insertEdge(std::uint64_t key, std::int32_t next);
+    void grow();
+    void rebuild();
+};
+
+#endif // CHORDMATCHER_H
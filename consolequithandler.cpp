@@ -0,0 +1,90 @@
+#include "consolequithandler.h"
+
+#ifdef _WIN32
+
+HANDLE ConsoleQuitHandler::s_cleanedUp = nullptr;
+
+ConsoleQuitHandler::ConsoleQuitHandler(QCoreApplication &) {
+    s_cleanedUp = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    SetConsoleCtrlHandler(&ConsoleQuitHandler::onConsoleEvent, TRUE);
+}
+
+ConsoleQuitHandler::~ConsoleQuitHandler() {
+    SetConsoleCtrlHandler(&ConsoleQuitHandler::onConsoleEvent, FALSE);
+    cleanedUp(); // Never leave a handler waiting
+}
+
+void ConsoleQuitHandler::cleanedUp() {
+    if (s_cleanedUp) SetEvent(s_cleanedUp);
+}
+
+BOOL WINAPI ConsoleQuitHandler::onConsoleEvent(DWORD type) {
+    switch (type) {
+    case CTRL_C_EVENT:
+    case CTRL_BREAK_EVENT:
+    case CTRL_CLOSE_EVENT:
+    case CTRL_LOGOFF_EVENT:
+    case CTRL_SHUTDOWN_EVENT:
+        // A normal thread, not a signal context, so posting is fine
+        QMetaObject::invokeMethod(QCoreApplication::instance(), &QCoreApplication::quit, Qt::QueuedConnection);
+        // For close, logoff and shutdown the process dies once this returns
+        WaitForSingleObject(s_cleanedUp, INFINITE);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+#else
+
+#include <QSocketNotifier>
+#include <cerrno>
+#include <csignal>
+#include <sys/socket.h>
+#include <unistd.h>
+
+int ConsoleQuitHandler::s_signalFds[2] = { -1, -1 };
+
+namespace {
+
+constexpr int QuitSignals[] = { SIGINT, SIGTERM, SIGHUP };
+
+} // namespace
+
+ConsoleQuitHandler::ConsoleQuitHandler(QCoreApplication &app) {
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, s_signalFds) != 0) return;
+
+    m_notifier = std::make_unique<QSocketNotifier>(s_signalFds[1], QSocketNotifier::Read);
+    QObject::connect(m_notifier.get(), &QSocketNotifier::activated, &app, [&app] {
+        char byte;
+        (void)!::read(s_signalFds[1], &byte, 1);
+        app.quit();
+    });
+
+    struct sigaction action = {};
+    action.sa_handler = &ConsoleQuitHandler::onSignal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    for (int signal : QuitSignals) sigaction(signal, &action, nullptr);
+}
+
+ConsoleQuitHandler::~ConsoleQuitHandler() {
+    for (int signal : QuitSignals) std::signal(signal, SIG_DFL);
+    m_notifier.reset();
+    for (int &fd : s_signalFds) {
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+    }
+}
+
+void ConsoleQuitHandler::cleanedUp() {
+}
+
+void ConsoleQuitHandler::onSignal(int) {
+    // write() is async-signal-safe; the notifier does the rest on the main thread
+    const int savedErrno = errno;
+    const char byte = 1;
+    (void)!::write(s_signalFds[0], &byte, 1);
+    errno = savedErrno;
+}
+
+#endif
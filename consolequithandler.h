@@ -0,0 +1,42 @@
+#ifndef CONSOLEQUITHANDLER_H
+#define CONSOLEQUITHANDLER_H
+
+#include <QCoreApplication>
+#include <memory>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+class QSocketNotifier;
+#endif
+
+// Turns Ctrl+C, termination and closing the console into an ordinary
+// QCoreApplication::quit(), so aboutToQuit handlers still run. On POSIX the
+// signal handler only writes a byte to a socket pair and a QSocketNotifier
+// quits from the event loop; nothing else is async-signal-safe. On Windows
+// the console handler runs on a thread of its own and holds off process
+// termination until cleanedUp() is called. One instance at a time.
+class ConsoleQuitHandler {
+public:
+    explicit ConsoleQuitHandler(QCoreApplication &app);
+    ~ConsoleQuitHandler();
+
+    ConsoleQuitHandler(const ConsoleQuitHandler&) = delete;
+    ConsoleQuitHandler& operator=(const ConsoleQuitHandler&) = delete;
+
+    // Call at the end of aboutToQuit; lets a pending console close go ahead
+    void cleanedUp();
+
+private:
+#ifdef _WIN32
+    static BOOL WINAPI onConsoleEvent(DWORD type);
+    static HANDLE s_cleanedUp;
+#else
+    static void onSignal(int signal);
+    static int s_signalFds[2];
+    std::unique_ptr<QSocketNotifier> m_notifier;
+#endif
+};
+
+#endif // CONSOLEQUITHANDLER_H
@@ -0,0 +1,67 @@
+#include "hotkeybinding.h"
+#include <algorithm>
+
+bool HotkeyBinding::conflictsWith(const HotkeyBinding &other) const {
+    if (isEmpty() || other.isEmpty()) return false;
+
+    const auto &longer = chords.size() >= other.chords.size() ? chords : other.chords;
+    const auto &shorter = chords.size() >= other.chords.size() ? other.chords : chords;
+    return std::search(longer.begin(), longer.end(), shorter.begin(), shorter.end()) != longer.end();
+}
+
+namespace {
+
+// The keys utils.cpp can map to virtual keys; Qt::Key_unknown for the rest
+Qt::Key keyFromText(QStringView text) {
+    if (text.size() == 1 && text[0].isLetterOrNumber() && text[0].unicode() < 0x80) {
+        return Qt::Key(text[0].toUpper().unicode());
+    }
+    if (text.size() > 1 && (text[0] == u'F' || text[0] == u'f')) {
+        bool ok = false;
+        const int n = text.mid(1).toInt(&ok);
+        if (ok && n >= 1 && n <= 12) return Qt::Key(Qt::Key_F1 + n - 1);
+    }
+
+    static const struct { const char16_t *name; Qt::Key key; } named[] = {
+        { u"Esc", Qt::Key_Escape },
+        { u"Del", Qt::Key_Delete },
+        { u"Space", Qt::Key_Space },
+        { u"Backspace", Qt::Key_Backspace },
+        { u"Tab", Qt::Key_Tab },
+    };
+    for (const auto &entry : named) {
+        if (text.compare(QStringView(entry.name), Qt::CaseInsensitive) == 0) return entry.key;
+    }
+    return Qt::Key_unknown;
+}
+
+Qt::KeyboardModifier modifierFromText(QStringView text) {
+    if (text.compare(u"Ctrl", Qt::CaseInsensitive) == 0)  return Qt::ControlModifier;
+    if (text.compare(u"Alt", Qt::CaseInsensitive) == 0)   return Qt::AltModifier;
+    if (text.compare(u"Shift", Qt::CaseInsensitive) == 0) return Qt::ShiftModifier;
+    if (text.compare(u"Meta", Qt::CaseInsensitive) == 0)  return Qt::MetaModifier;
+    return Qt::NoModifier;
+}
+
+} // namespace
+
+HotkeyBinding HotkeyBinding::fromPortableText(int id, QStringView text) {
+    HotkeyBinding binding;
+    binding.id = id;
+    if (text.trimmed().isEmpty()) return binding;
+
+    for (QStringView chord : text.split(u',')) {
+        const QList<QStringView> parts = chord.trimmed().split(u'+');
+        Qt::KeyboardModifiers modifiers;
+        for (qsizetype i = 0; i + 1 < parts.size(); ++i) {
+            const Qt::KeyboardModifier modifier = modifierFromText(parts[i].trimmed());
+            if (modifier == Qt::NoModifier) return HotkeyBinding{ id, {} };
+            modifiers |= modifier;
+        }
+
+        const Qt::Key key = keyFromText(parts.last().trimmed());
+        if (key == Qt::Key_unknown) return HotkeyBinding{ id, {} };
+        binding.chords << QKeyCombination(modifiers, key);
+    }
+    return binding;
+}
@@ -0,0 +1,28 @@
+#ifndef HOTKEYBINDING_H
+#define HOTKEYBINDING_H
+
+#include <QKeyCombination>
+#include <QList>
+#include <QStringView>
+
+// A global hotkey: one chord ("Ctrl+G") or a sequence of chords
+// ("Ctrl+K, Ctrl+M"). id is what PlatformBackend::onHotkeyPressed reports back.
+struct HotkeyBinding {
+    int id = 0;
+    QList<QKeyCombination> chords;
+
+    bool isEmpty() const { return chords.isEmpty(); }
+    bool isMultiChord() const { return chords.size() > 1; }
+
+    // True if one binding contains the other anywhere (equal, prefix, suffix
+    // or infix) - the shorter one would always fire first, so they can't
+    // both be registered
+    bool conflictsWith(const HotkeyBinding &other) const;
+
+    // Parses what QKeySequence::toString() stores in the settings ("Ctrl+K,
+    // Ctrl+M") without needing QtGui. Any chord that doesn't parse makes the
+    // whole binding empty.
+    static HotkeyBinding fromPortableText(int id, QStringView text);
+};
+
+#endif // HOTKEYBINDING_H
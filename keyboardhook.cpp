@@ -0,0 +1,95 @@
+#include "keyboardhook.h"
+#include <future>
+
+KeyboardHook* KeyboardHook::s_instance = nullptr;
+
+namespace {
+
+bool isModifierVk(DWORD vk) {
+    switch (vk) {
+    case VK_SHIFT: case VK_LSHIFT: case VK_RSHIFT:
+    case VK_CONTROL: case VK_LCONTROL: case VK_RCONTROL:
+    case VK_MENU: case VK_LMENU: case VK_RMENU:
+    case VK_LWIN: case VK_RWIN:
+        return true;
+    }
+    return false;
+}
+
+bool isDown(int vk) {
+    return (GetAsyncKeyState(vk) & 0x8000) != 0;
+}
+
+// Same MOD_* mask registerHotkeys() hands to RegisterHotKey
+UINT currentModifiers() {
+    UINT mod = 0;
+    if (isDown(VK_CONTROL)) mod |= MOD_CONTROL;
+    if (isDown(VK_MENU))    mod |= MOD_ALT;
+    if (isDown(VK_SHIFT))   mod |= MOD_SHIFT;
+    if (isDown(VK_LWIN) || isDown(VK_RWIN)) mod |= MOD_WIN;
+    return mod;
+}
+
+} // namespace
+
+KeyboardHook::~KeyboardHook() {
+    uninstall();
+}
+
+bool KeyboardHook::install() {
+    if (isInstalled()) return true;
+    if (s_instance) return false;
+
+    m_matcher.reset();
+    m_targetThreadId = GetCurrentThreadId();
+    s_instance = this;
+
+    std::promise<bool> installed;
+    std::future<bool> result = installed.get_future();
+    m_hookThread = std::thread([this, &installed] {
+        // Create the message queue before anyone can post WM_QUIT to it
+        MSG msg;
+        PeekMessageW(&msg, nullptr, WM_USER, WM_USER, PM_NOREMOVE);
+        m_hookThreadId = GetCurrentThreadId();
+
+        HHOOK hook = SetWindowsHookExW(WH_KEYBOARD_LL, &KeyboardHook::hookProc, GetModuleHandleW(nullptr), 0);
+        installed.set_value(hook != nullptr);
+        if (!hook) return;
+
+        // The hook is called from inside GetMessage
+        while (GetMessageW(&msg, nullptr, 0, 0) > 0) {
+        }
+        UnhookWindowsHookEx(hook);
+    });
+
+    if (!result.get()) {
+        m_hookThread.join();
+        s_instance = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void KeyboardHook::uninstall() {
+    if (!isInstalled()) return;
+    PostThreadMessageW(m_hookThreadId, WM_QUIT, 0, 0);
+    m_hookThread.join();
+    s_instance = nullptr;
+}
+
+LRESULT CALLBACK KeyboardHook::hookProc(int nCode, WPARAM wParam, LPARAM lParam) {
+    // Windows silently drops hooks that take too long: match and post, nothing else
+    if (nCode == HC_ACTION && s_instance && (wParam == WM_KEYDOWN || wParam == WM_SYSKEYDOWN)) {
+        const auto* kb = reinterpret_cast<const KBDLLHOOKSTRUCT*>(lParam);
+        if (!isModifierVk(kb->vkCode)) {
+            ChordMatcher::Chord chord = ChordMatcher::makeChord(
+                std::uint16_t(currentModifiers()), std::uint16_t(kb->vkCode));
+            int id = s_instance->m_matcher.feed(chord, kb->time);
+            if (id != ChordMatcher::NoMatch) {
+                PostThreadMessageW(s_instance->m_targetThreadId, WM_HOTKEY, WPARAM(id), 0);
+                return 1; // Swallow the final chord, as RegisterHotKey would
+            }
+        }
+    }
+    return CallNextHookEx(nullptr, nCode, wParam, lParam);
+}
@@ -0,0 +1,45 @@
+#ifndef KEYBOARDHOOK_H
+#define KEYBOARDHOOK_H
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <thread>
+#include "chordmatcher.h"
+
+// Low-level keyboard hook for hotkeys RegisterHotKey can't express
+// (multi-chord sequences). Chords are built from MOD_* flags and virtual-key
+// codes. A completed sequence is posted to the installing thread as WM_HOTKEY
+// with the sequence id in wParam, so HotkeyEventFilter dispatches it exactly
+// like a registered hotkey. Only one instance can be installed at a time.
+//
+// The hook lives on its own thread running nothing but a message loop. A
+// low-level hook is called on the thread that installed it, so on the GUI
+// thread any slow work would stall system-wide keyboard input and eventually
+// get the hook silently removed (LowLevelHooksTimeout).
+class KeyboardHook {
+public:
+    KeyboardHook() = default;
+    ~KeyboardHook();
+
+    KeyboardHook(const KeyboardHook&) = delete;
+    KeyboardHook& operator=(const KeyboardHook&) = delete;
+
+    // The hook thread feeds the matcher: edit it only while uninstalled
+    ChordMatcher& matcher() { return m_matcher; }
+
+    // Starts the hook thread; returns once the hook is set (or failed to be)
+    bool install();
+    void uninstall();
+    bool isInstalled() const { return m_hookThread.joinable(); }
+
+private:
+    static LRESULT CALLBACK hookProc(int nCode, WPARAM wParam, LPARAM lParam);
+    static KeyboardHook* s_instance;
+
+    std::thread m_hookThread;
+    DWORD m_hookThreadId = 0;
+    DWORD m_targetThreadId = 0; // Receives the WM_HOTKEY posts
+    ChordMatcher m_matcher;
+};
+
+#endif // KEYBOARDHOOK_H
@@ -1,6 +1,7 @@
 #include "mainwindow.h"
 
 #include <QApplication>
+#include <QTimer>
 
 int main(int argc, char *argv[])
 {
@@ -9,10 +10,15 @@ int main(int argc, char *argv[])
     MainWindow w;
     // Check if started minimized
     QStringList args = QCoreApplication::arguments();
-    if (args.size() > 1 && args[1] == "--minimized") {
+    if (args.contains("--minimized")) {
         w.hide(); // Start hidden, tray icon will be visible
     } else {
         w.show();
     }
+    // --quit-after <ms>: for startup and memory measurements in CI
+    const int quitAfter = args.indexOf("--quit-after");
+    if (quitAfter >= 0 && quitAfter + 1 < args.size()) {
+        QTimer::singleShot(args[quitAfter + 1].toInt(), &a, &QCoreApplication::quit);
+    }
     return a.exec();
 }
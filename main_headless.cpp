@@ -0,0 +1,75 @@
+#include <QCoreApplication>
+#include <QDebug>
+#include <QSettings>
+#include <QTimer>
+#include "consolequithandler.h"
+#include "hotkeybinding.h"
+#include "platformbackend.h"
+#include "processsnapshotrefresher.h"
+#include "windowactiondispatcher.h"
+#include "windowactions.h"
+
+// The minimizer without tray or window, on QtCore alone. Reads the settings
+// the GUI saves, so configure it there and run this one to keep the
+// footprint down. Ctrl+C or closing the console quits and restores
+// whatever it hid.
+
+namespace {
+
+enum HotkeyId {
+    MinimizeHotkeyId = 1,
+    MaximizeHotkeyId = 2,
+};
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    ConsoleQuitHandler consoleQuit(a);
+
+    // --quit-after <ms>: for startup and memory measurements in CI
+    const QStringList args = QCoreApplication::arguments();
+    const int quitAfter = args.indexOf("--quit-after");
+    if (quitAfter >= 0 && quitAfter + 1 < args.size()) {
+        QTimer::singleShot(args[quitAfter + 1].toInt(), &a, &QCoreApplication::quit);
+    }
+
+    QSettings settings("MrGrey", "Minimizer");
+    const QStringList processNames = settings.value("processList").toStringList();
+    const HotkeyBinding minBinding = HotkeyBinding::fromPortableText(
+        MinimizeHotkeyId, settings.value("minHotkey", "Ctrl+G").toString());
+    const HotkeyBinding maxBinding = HotkeyBinding::fromPortableText(
+        MaximizeHotkeyId, settings.value("maxHotkey", "Ctrl+H").toString());
+
+    std::unique_ptr<PlatformBackend> backend = createPlatformBackend();
+    ProcessSnapshotPublisher snapshots;
+    ProcessSnapshotRefresher refresher(*backend, snapshots);
+    WindowActionDispatcher dispatcher(*backend);
+
+    backend->onHotkeyPressed = [&](int id) {
+        const WindowAction action = id == MinimizeHotkeyId ? WindowAction::Minimize : WindowAction::Restore;
+        dispatchToProcessWindows(snapshots, *backend, dispatcher, processNames, action, [&a](WindowActionReport report) {
+            QMetaObject::invokeMethod(&a, [report = std::move(report)]() {
+                traceWindowActionReport(report);
+            }, Qt::QueuedConnection);
+        });
+    };
+
+    // Keep running without hotkeys, like the GUI does
+    if (minBinding.conflictsWith(maxBinding)) {
+        qWarning() << "Minimize and maximize hotkeys must be different, and neither may contain the other.";
+    } else if (!backend->registerHotkey(minBinding) || !backend->registerHotkey(maxBinding)) {
+        qWarning() << "Hotkeys are invalid or already in use by another app.";
+        backend->unregisterHotkeys();
+    } else {
+        qDebug() << "Hotkeys registered for" << processNames;
+    }
+
+    QObject::connect(&a, &QCoreApplication::aboutToQuit, [&] {
+        backend->unregisterHotkeys();
+        dispatcher.releaseHiddenWindows();
+        consoleQuit.cleanedUp();
+    });
+    return a.exec();
+}
@@ -1,37 +1,28 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
-#include <Windows.h>
-#include <QAbstractNativeEventFilter>
 #include <QDebug>
-#include <TlHelp32.h>   // For process snapshot
-#include <Psapi.h>      // For GetModuleBaseName
 #include <QCloseEvent>
 #include <QSettings>
 #include <QMenu>
 #include <QMessageBox>
 #include <QTimer>
 #include "ProcessPickerDialog.h"
-#include "win32utils.h"
-#include "utils.h"
-// #pragma comment(lib, "Psapi.lib")
+#include "windowactions.h"
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
+    , backend(createPlatformBackend())
+    , snapshotRefresher(std::make_unique<ProcessSnapshotRefresher>(*backend, processSnapshots))
+    , windowDispatcher(std::make_unique<WindowActionDispatcher>(*backend))
 {
     ui->setupUi(this);
 
-    // Create and install native hotkey filter
-    qApp->installNativeEventFilter(&hotkeyFilter);
-
-    minimizeHotkeyId = GlobalAddAtom(L"MrGrey_Minimizer_Min_Key");
-    maximizeHotkeyId = GlobalAddAtom(L"MrGrey_Minimizer_Max_Key");
-
-    hotkeyFilter.onHotkeyPressed = [this](int id) {
-        if (id == minimizeHotkeyId) {
+    backend->onHotkeyPressed = [this](int id) {
+        if (id == MinimizeHotkeyId) {
             qDebug() << "Minimize hotkey triggered!";
             minimizeProcessWindows();
-        } else if (id == maximizeHotkeyId) {
+        } else if (id == MaximizeHotkeyId) {
             qDebug() << "Maximize hotkey triggered!";
             maximizeProcessWindows();
         }
@@ -61,9 +52,9 @@ void MainWindow::changeEvent(QEvent* event) {
 
 MainWindow::~MainWindow()
 {
-    qApp->removeNativeEventFilter(&hotkeyFilter);
-    GlobalDeleteAtom(minimizeHotkeyId);
-    GlobalDeleteAtom(maximizeHotkeyId);
+    backend->unregisterHotkeys();
+    // Windows we hid wouldn't show up in a snapshot again after we exit
+    windowDispatcher->releaseHiddenWindows();
     if (trayIcon) {
         trayIcon->hide(); // Forces Windows to remove the icon immediately
         delete trayIcon;
@@ -72,41 +63,28 @@ MainWindow::~MainWindow()
 }
 
 void MainWindow::registerHotkeys() {
-    UnregisterHotKey(nullptr, minimizeHotkeyId);
-    UnregisterHotKey(nullptr, maximizeHotkeyId);
+    backend->unregisterHotkeys();
 
     minimizeKey = ui->hotkeyMinimize->keySequence();
     maximizeKey = ui->hotkeyMaximize->keySequence();
 
-    if (minimizeKey == maximizeKey) {
-        QMessageBox::warning(this, "Hotkey Conflict", "Minimize and maximize hotkeys must be different.");
-        return;
-    }
-
-    UINT minMod = 0, minVk = 0, maxMod = 0, maxVk = 0;
-
-    auto extract = [](const QKeySequence &seq, UINT &mod, UINT &vk) {
-        mod = 0;
-        vk = 0;
-        if (seq.isEmpty()) return;
-
-        QKeyCombination combination = seq[0];
-
-        Qt::KeyboardModifiers qMods = combination.keyboardModifiers();
-        if (qMods & Qt::ControlModifier) mod |= MOD_CONTROL;
-        if (qMods & Qt::AltModifier)     mod |= MOD_ALT;
-        if (qMods & Qt::ShiftModifier)   mod |= MOD_SHIFT;
-        if (qMods & Qt::MetaModifier)    mod |= MOD_WIN;
-
-        Qt::Key qKey = combination.key();
-
-        vk = qtKeyToWinVK(qKey);
+    auto toBinding = [](int id, const QKeySequence &seq) {
+        HotkeyBinding binding;
+        binding.id = id;
+        for (int i = 0; i < seq.count(); ++i) binding.chords << seq[i];
+        return binding;
     };
 
-    extract(minimizeKey, minMod, minVk);
-    extract(maximizeKey, maxMod, maxVk);
+    HotkeyBinding minBinding = toBinding(MinimizeHotkeyId, minimizeKey);
+    HotkeyBinding maxBinding = toBinding(MaximizeHotkeyId, maximizeKey);
+
+    if (minimizeKey == maximizeKey || minBinding.conflictsWith(maxBinding)) {
+        QMessageBox::warning(this, "Hotkey Conflict",
+                             "Minimize and maximize hotkeys must be different, and neither may contain the other.");
+        return;
+    }
 
-    bool minRegistered = RegisterHotKey(nullptr, minimizeHotkeyId, minMod, minVk);
+    bool minRegistered = backend->registerHotkey(minBinding);
     if (!minRegistered) {
         QMessageBox::warning(this, "Hotkey Registration Failed",
                              "Minimize hotkey is already in use by another app or invalid.");
@@ -114,11 +92,11 @@ void MainWindow::registerHotkeys() {
     }
 
 
-    bool maxRegistered = RegisterHotKey(nullptr, maximizeHotkeyId, maxMod, maxVk);
+    bool maxRegistered = backend->registerHotkey(maxBinding);
     if (!maxRegistered) {
         QMessageBox::warning(this, "Hotkey Registration Failed",
                              "Maximize hotkey is already in use or invalid.");
-        UnregisterHotKey(nullptr, 1);
+        backend->unregisterHotkeys();
         return;
     }
     qDebug() << "Hotkeys registered.";
@@ -158,100 +136,37 @@ void MainWindow::iconActivated(QSystemTrayIcon::ActivationReason reason) {
 }
 
 
-bool isTargetProcessWindow(HWND hwnd, const std::vector<DWORD>& targetPIDs) {
-    DWORD windowPID = 0;
-    GetWindowThreadProcessId(hwnd, &windowPID);
-    return std::find(targetPIDs.begin(), targetPIDs.end(), windowPID) != targetPIDs.end()
-           && IsWindowVisible(hwnd)
-           && (GetWindow(hwnd, GW_OWNER) == nullptr); // Top-level only
-}
-
-struct WindowSearchContext {
-    std::vector<DWORD> pids;
-    std::vector<HWND> hwnds;
-};
-
-
-std::vector<HWND> getProcessWindows(const QStringList& processNames) {
-    std::unordered_set<DWORD> targetPids;
-
-    QSet<QString> targetsLower;
-    for (const auto& name : processNames) targetsLower.insert(name.toLower());
-
-    // --- Phase 1: Get PIDs (The Snapshot) ---
-    ScopedHandle snapshot(CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0));
-    if (snapshot.get() != INVALID_HANDLE_VALUE) {
-        PROCESSENTRY32 pe;
-        pe.dwSize = sizeof(PROCESSENTRY32);
-
-        if (Process32First(snapshot.get(), &pe)) {
-            do {
-                // Fast comparison using QSet lookup
-                QString exeName = QString::fromWCharArray(pe.szExeFile).toLower();
-                if (targetsLower.contains(exeName)) {
-                    targetPids.insert(pe.th32ProcessID);
-                }
-            } while (Process32Next(snapshot.get(), &pe));
-        }
-    }
-
-    // Early exit if no processes found (saves walking windows)
-    if (targetPids.empty()) return {};
-
-    // --- Phase 2: Get Windows (The Lightweight Walk) ---
-    struct Context {
-        const std::unordered_set<DWORD>* pids;
-        std::vector<HWND> hwnds;
-    };
-    Context ctx { &targetPids, {} };
-
-    EnumWindows([](HWND hwnd, LPARAM lParam) -> BOOL {
-        auto* c = reinterpret_cast<Context*>(lParam);
-
-        // Filter 1: Visibility (Fastest check)
-        if (!IsWindowVisible(hwnd)) return TRUE;
-
-        // Filter 2: PID Check (O(1) Set Lookup)
-        DWORD pid;
-        GetWindowThreadProcessId(hwnd, &pid);
-
-        if (c->pids->count(pid)) {
-            // Filter 3: Ownership (Prevent minimizing tooltips/popups)
-            if (GetWindow(hwnd, GW_OWNER) == nullptr) {
-                c->hwnds.push_back(hwnd);
-            }
-        }
-        return TRUE;
-    }, reinterpret_cast<LPARAM>(&ctx));
-
-    return ctx.hwnds;
-}
-
-
-void MainWindow::minimizeProcessWindows() {
+void MainWindow::applyToProcessWindows(WindowAction action) {
     QStringList processNames;
     for (int i = 0; i < ui->listWidgetProcesses->count(); ++i) {
         processNames << ui->listWidgetProcesses->item(i)->text();
     }
 
-    auto hwnds = getProcessWindows(processNames);
+    // Runs on a dispatcher worker; hop back to the GUI thread with the report
+    dispatchToProcessWindows(processSnapshots, *backend, *windowDispatcher, processNames, action, [this](WindowActionReport report) {
+        QMetaObject::invokeMethod(this, [this, report = std::move(report)]() {
+            reportWindowActions(report);
+        }, Qt::QueuedConnection);
+    });
+}
 
-    for (HWND hwnd : hwnds) {
-        ShowWindowAsync(hwnd, SW_MINIMIZE);
+void MainWindow::reportWindowActions(const WindowActionReport &report) {
+    traceWindowActionReport(report);
+
+    const int timedOut = report.count(WindowActionOutcome::Result::TimedOut);
+    if (timedOut > 0) {
+        trayIcon->showMessage("Minimizer", QString("%1 window(s) did not respond.").arg(timedOut),
+                              QSystemTrayIcon::Warning);
     }
 }
 
-void MainWindow::maximizeProcessWindows() {
-    QStringList processNames;
-    for (int i = 0; i < ui->listWidgetProcesses->count(); ++i) {
-        processNames << ui->listWidgetProcesses->item(i)->text();
-    }
 
-    auto hwnds = getProcessWindows(processNames);
+void MainWindow::minimizeProcessWindows() {
+    applyToProcessWindows(WindowAction::Minimize);
+}
 
-    for (HWND hwnd : hwnds) {
-        ShowWindowAsync(hwnd, SW_RESTORE);
-    }
+void MainWindow::maximizeProcessWindows() {
+    applyToProcessWindows(WindowAction::Restore);
 }
 
 void MainWindow::loadSettings() {
@@ -282,53 +197,9 @@ void MainWindow::saveSettings() {
     settings.setValue("launchAtStartup", ui->checkBoxLaunchAtStartup->isChecked() ? "true" : "false");
 }
 
-bool addToStartup() {
-    wchar_t exePath[MAX_PATH];
-    if (GetModuleFileNameW(NULL, exePath, MAX_PATH) == 0) return false;
-
-    HKEY rawKey = nullptr;
-    LONG result = RegOpenKeyExW(HKEY_CURRENT_USER,
-                                L"Software\\Microsoft\\Windows\\CurrentVersion\\Run",
-                                0, KEY_WRITE, &rawKey);
-
-    if (result != ERROR_SUCCESS) return false;
-
-    // RAII: Key automatically closes when this scope ends (even if RegSetValueExW throws/fails)
-    ScopedRegistryKey hKey(rawKey);
-
-    std::wstring value = std::wstring(L"\"") + exePath + L"\" --minimized";
-
-    result = RegSetValueExW(hKey.get(), L"MinimizerApp", 0, REG_SZ,
-                            reinterpret_cast<const BYTE*>(value.c_str()),
-                            (value.size() + 1) * sizeof(wchar_t));
-
-    qDebug("Added to startup.");
-    return (result == ERROR_SUCCESS);
-}
-
-bool removeFromStartup() {
-    HKEY rawKey = nullptr;
-    LONG result = RegOpenKeyExW(HKEY_CURRENT_USER,
-                                L"Software\\Microsoft\\Windows\\CurrentVersion\\Run",
-                                0, KEY_WRITE, &rawKey);
-
-    if (result != ERROR_SUCCESS) return false;
-
-    // RAII Wrapper
-    ScopedRegistryKey hKey(rawKey);
-
-    result = RegDeleteValueW(hKey.get(), L"MinimizerApp");
-
-    qDebug("Removed from startup");
-    return (result == ERROR_SUCCESS);
-}
-
 void MainWindow::on_checkBoxLaunchAtStartup_stateChanged(int arg1)
 {
-    if (arg1) {
-        addToStartup();
-    } else
-        removeFromStartup();
+    backend->setLaunchAtStartup(arg1 != 0);
 }
 
 
@@ -360,7 +231,8 @@ void MainWindow::on_btnAddProcess_clicked()
 
 void MainWindow::on_btnSelectProcess_clicked()
 {
-    ProcessPickerDialog dlg(this);
+    // Shows the latest refresh; the list is at most one interval old
+    ProcessPickerDialog dlg(processSnapshots, *backend, this);
     if (dlg.exec() == QDialog::Accepted) {
         ui->lineEditProcess->setText(dlg.selectedProcess());
     }
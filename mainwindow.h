@@ -3,7 +3,11 @@
 
 #include <QMainWindow>
 #include <QSystemTrayIcon>
-#include "hotkeyeventfilter.h"
+#include <memory>
+#include "platformbackend.h"
+#include "processsnapshot.h"
+#include "processsnapshotrefresher.h"
+#include "windowactiondispatcher.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
@@ -31,14 +35,22 @@ private:
     QString targetProcess;
     QKeySequence minimizeKey;
     QKeySequence maximizeKey;
-    HotkeyEventFilter hotkeyFilter;
-    int minimizeHotkeyId;
-    int maximizeHotkeyId;
+    std::unique_ptr<PlatformBackend> backend;
+    ProcessSnapshotPublisher processSnapshots; // Read by the hotkeys and the process picker
+    std::unique_ptr<ProcessSnapshotRefresher> snapshotRefresher;
+    std::unique_ptr<WindowActionDispatcher> windowDispatcher;
+
+    enum HotkeyId {
+        MinimizeHotkeyId = 1,
+        MaximizeHotkeyId = 2,
+    };
 
     void createTrayIcon();
     void closeEvent(QCloseEvent *event) override;
     void changeEvent(QEvent* event) override;
     void registerHotkeys();
+    void applyToProcessWindows(WindowAction action);
+    void reportWindowActions(const WindowActionReport &report);
     void minimizeProcessWindows();
     void maximizeProcessWindows();
     void loadSettings();
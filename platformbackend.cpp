@@ -0,0 +1,32 @@
+#include "platformbackend.h"
+
+#ifdef _WIN32
+#include "win32backend.h"
+#endif
+
+namespace {
+
+// Lets the core build and run (empty snapshots, no hotkeys) where there is
+// no real backend yet
+class NullBackend : public PlatformBackend {
+public:
+    std::unique_ptr<ProcessSnapshot> captureProcesses() override { return std::make_unique<ProcessSnapshot>(); }
+    std::vector<ProcessSnapshot::WindowHandle> captureWindows(std::vector<ProcessSnapshot::Pid>) override { return {}; }
+    QString processImagePath(ProcessSnapshot::Pid) override { return QString(); }
+    void applyWindowAction(ProcessSnapshot::WindowHandle, WindowAction) override {}
+    WindowState windowState(ProcessSnapshot::WindowHandle) override { return WindowState::Gone; }
+    bool isResponding(ProcessSnapshot::WindowHandle) override { return true; }
+    bool registerHotkey(const HotkeyBinding &) override { return false; }
+    void unregisterHotkeys() override {}
+    bool setLaunchAtStartup(bool) override { return false; }
+};
+
+} // namespace
+
+std::unique_ptr<PlatformBackend> createPlatformBackend() {
+#ifdef _WIN32
+    return std::make_unique<Win32Backend>();
+#else
+    return std::make_unique<NullBackend>();
+#endif
+}
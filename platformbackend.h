@@ -0,0 +1,38 @@
+#ifndef PLATFORMBACKEND_H
+#define PLATFORMBACKEND_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include <QString>
+#include "hotkeybinding.h"
+#include "processsnapshot.h"
+#include "windowmanager.h"
+
+// Everything the app needs from the OS. The GUI only talks to this
+// interface, so the core links and runs without windows.h.
+class PlatformBackend : public WindowManager {
+public:
+    // Called with HotkeyBinding::id when a registered hotkey fires
+    std::function<void(int)> onHotkeyPressed;
+
+    // All processes plus their visible, unowned top-level windows
+    virtual std::unique_ptr<ProcessSnapshot> captureProcesses() = 0;
+    // Current visible, unowned top-level windows of just these processes.
+    // Doesn't enumerate windows at all when pids is empty.
+    virtual std::vector<ProcessSnapshot::WindowHandle> captureWindows(std::vector<ProcessSnapshot::Pid> pids) = 0;
+
+    // Full path of the process's executable; empty if it's gone or off limits
+    virtual QString processImagePath(ProcessSnapshot::Pid pid) = 0;
+
+    // Returns false if the hotkey is invalid or taken by another app
+    virtual bool registerHotkey(const HotkeyBinding &binding) = 0;
+    virtual void unregisterHotkeys() = 0;
+
+    virtual bool setLaunchAtStartup(bool enabled) = 0;
+};
+
+// The backend for the platform this was built for
+std::unique_ptr<PlatformBackend> createPlatformBackend();
+
+#endif // PLATFORMBACKEND_H
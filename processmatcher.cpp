@@ -0,0 +1,37 @@
+#include "processmatcher.h"
+
+ProcessMatcher::ProcessMatcher(const QStringList &processNames)
+    : m_targets(processNames) {
+}
+
+bool ProcessMatcher::matches(std::u16string_view exeName) const {
+    // Called for every running process: compare in place instead of
+    // building a lowercased copy of each name. The list is a handful long.
+    const QStringView name(exeName.data(), qsizetype(exeName.size()));
+    for (const QString &target : m_targets) {
+        if (name.compare(target, Qt::CaseInsensitive) == 0) return true;
+    }
+    return false;
+}
+
+std::vector<ProcessSnapshot::WindowHandle> ProcessMatcher::windows(const ProcessSnapshot &snapshot) const {
+    std::vector<ProcessSnapshot::WindowHandle> result;
+    for (std::size_t i = 0; i < snapshot.size(); ++i) {
+        // Skip the name comparison for processes without windows
+        if (snapshot.windows(i).empty() || !matches(snapshot.name(i))) continue;
+
+        for (ProcessSnapshot::WindowHandle window : snapshot.windows(i)) {
+            result.push_back(window);
+        }
+    }
+    return result;
+}
+
+std::vector<ProcessSnapshot::Pid> ProcessMatcher::pids(const ProcessSnapshot &snapshot) const {
+    std::vector<ProcessSnapshot::Pid> result;
+    if (isEmpty()) return result;
+    for (std::size_t i = 0; i < snapshot.size(); ++i) {
+        if (matches(snapshot.name(i))) result.push_back(snapshot.pid(i));
+    }
+    return result;
+}
@@ -0,0 +1,25 @@
+#ifndef PROCESSMATCHER_H
+#define PROCESSMATCHER_H
+
+#include <QString>
+#include <QStringList>
+#include <vector>
+#include "processsnapshot.h"
+
+// Selects the windows of processes whose executable name is in a list,
+// case-insensitively ("notepad.exe" matches "Notepad.EXE")
+class ProcessMatcher {
+public:
+    explicit ProcessMatcher(const QStringList &processNames);
+
+    bool isEmpty() const { return m_targets.isEmpty(); }
+    bool matches(std::u16string_view exeName) const;
+    std::vector<ProcessSnapshot::WindowHandle> windows(const ProcessSnapshot &snapshot) const;
+    // Every matching process, with or without windows in the snapshot
+    std::vector<ProcessSnapshot::Pid> pids(const ProcessSnapshot &snapshot) const;
+
+private:
+    QStringList m_targets;
+};
+
+#endif // PROCESSMATCHER_H
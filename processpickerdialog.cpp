@@ -1,17 +1,18 @@
 #include "processpickerdialog.h"
 #include "ui_processpickerdialog.h"
-#include "win32utils.h"
 
-#include <tlhelp32.h>
-#include <shellapi.h>
+#include <QFileIconProvider>
+#include <QFileInfo>
 #include <QIcon>
-#include <QPixmap>
 #include <QMessageBox>
+#include <QSet>
 
-ProcessPickerDialog::ProcessPickerDialog(QWidget *parent) :
+ProcessPickerDialog::ProcessPickerDialog(const ProcessSnapshotPublisher &snapshots, PlatformBackend &backend, QWidget *parent) :
     QDialog(parent),
     ui(new Ui::ProcessPickerDialog),
-    model(new QStandardItemModel(this))
+    model(new QStandardItemModel(this)),
+    m_snapshots(snapshots),
+    m_backend(backend)
 {
     ui->setupUi(this);
     ui->listView->setModel(model);
@@ -31,52 +32,38 @@ QString ProcessPickerDialog::selectedProcess() const
 void ProcessPickerDialog::populateProcessList() {
     model->clear();
 
-    ScopedHandle snapshot(CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0));
-    if (snapshot.get() == INVALID_HANDLE_VALUE) {
-        QMessageBox::warning(this, "Error", "Failed to get process snapshot");
-        return;
-    }
-
-    PROCESSENTRY32 pe;
-    pe.dwSize = sizeof(PROCESSENTRY32);
-
     struct ProcessItem {
+        ProcessSnapshot::Pid pid;
         QString name;
         QIcon icon;
     };
     QSet<QString> seen;
     QVector<ProcessItem> processItems;
 
-    if (Process32First(snapshot.get(), &pe)) {
-        do {
-            // Qt 6: QString::fromWCharArray takes size, -1 means null-terminated
-            QString exeName = QString::fromWCharArray(pe.szExeFile, -1);
+    {
+        // Copy out and let go of the snapshot: the icon lookups below take
+        // far too long to hold a read guard across
+        auto snapshot = m_snapshots.read();
+        for (std::size_t i = 0; i < snapshot->size(); ++i) {
+            std::u16string_view name = snapshot->name(i);
+            QString exeName = QStringView(name.data(), qsizetype(name.size())).toString();
 
             if (seen.contains(exeName)) continue;
             seen.insert(exeName);
+            processItems.append({ snapshot->pid(i), exeName, QIcon() });
+        }
+    }
 
-            WCHAR exePath[MAX_PATH] = {0};
-            ScopedHandle hProcess(OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pe.th32ProcessID));
-
-            ProcessItem item;
-            item.name = exeName;
-
-            if (hProcess) {
-                DWORD size = MAX_PATH;
-                if (QueryFullProcessImageName(hProcess.get(), 0, exePath, &size)) {
-                    SHFILEINFO shfi = {0};
-                    SHGetFileInfo(exePath, 0, &shfi, sizeof(shfi),
-                                  SHGFI_ICON | SHGFI_SMALLICON | SHGFI_SYSICONINDEX | SHGFI_USEFILEATTRIBUTES);
-
-                    if (shfi.hIcon) {
-                        item.icon = QIcon(QPixmap::fromImage(QImage::fromHICON(shfi.hIcon)));
-                        DestroyIcon(shfi.hIcon);
-                    }
-                }
-            }
-            processItems.append(item);
+    if (processItems.isEmpty()) {
+        QMessageBox::warning(this, "Error", "Failed to get process snapshot");
+        return;
+    }
 
-        } while (Process32Next(snapshot.get(), &pe));
+    QFileIconProvider iconProvider;
+    for (ProcessItem &item : processItems) {
+        // Empty for processes we may not query (system, elevated)
+        const QString exePath = m_backend.processImagePath(item.pid);
+        if (!exePath.isEmpty()) item.icon = iconProvider.icon(QFileInfo(exePath));
     }
 
     // Sort alphabetically
@@ -5,6 +5,8 @@
 
 #include <QDialog>
 #include <QStandardItemModel>
+#include "platformbackend.h"
+#include "processsnapshot.h"
 
 namespace Ui {
 class ProcessPickerDialog;
@@ -14,7 +16,7 @@ class ProcessPickerDialog : public QDialog {
     Q_OBJECT
 
 public:
-    explicit ProcessPickerDialog(QWidget *parent = nullptr);
+    ProcessPickerDialog(const ProcessSnapshotPublisher &snapshots, PlatformBackend &backend, QWidget *parent = nullptr);
     ~ProcessPickerDialog();
 
     QString selectedProcess() const;
@@ -27,6 +29,8 @@ private slots:
 private:
     Ui::ProcessPickerDialog *ui;
     QStandardItemModel* model;
+    const ProcessSnapshotPublisher &m_snapshots;
+    PlatformBackend &m_backend;
 
     QString m_selectedProcess;
 
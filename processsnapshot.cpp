@@ -0,0 +1,44 @@
+#include "processsnapshot.h"
+#include <unordered_map>
+#include <utility>
+
+void ProcessSnapshotBuilder::addProcess(ProcessSnapshot::Pid pid, ProcessSnapshot::Pid parentPid, std::u16string_view name) {
+    ProcessSnapshot& s = *m_snapshot;
+    s.m_pids.push_back(pid);
+    s.m_parentPids.push_back(parentPid);
+    s.m_namePool.append(name);
+    s.m_nameOffsets.push_back(std::uint32_t(s.m_namePool.size()));
+}
+
+void ProcessSnapshotBuilder::addWindow(ProcessSnapshot::Pid pid, ProcessSnapshot::WindowHandle window) {
+    m_windows.emplace_back(pid, window);
+}
+
+std::unique_ptr<ProcessSnapshot> ProcessSnapshotBuilder::build() {
+    ProcessSnapshot& s = *m_snapshot;
+
+    std::unordered_map<ProcessSnapshot::Pid, std::size_t> indexOf;
+    indexOf.reserve(s.m_pids.size());
+    for (std::size_t i = 0; i < s.m_pids.size(); ++i) indexOf.emplace(s.m_pids[i], i);
+
+    // Counting sort of windows by owning process index (stable, keeps Z-order)
+    std::vector<std::uint32_t> counts(s.m_pids.size() + 1, 0);
+    std::vector<std::size_t> owner(m_windows.size(), s.m_pids.size());
+    for (std::size_t w = 0; w < m_windows.size(); ++w) {
+        auto it = indexOf.find(m_windows[w].first);
+        if (it == indexOf.end()) continue;
+        owner[w] = it->second;
+        ++counts[it->second + 1];
+    }
+    for (std::size_t i = 1; i < counts.size(); ++i) counts[i] += counts[i - 1];
+
+    s.m_windowOffsets = counts;
+    s.m_windows.assign(counts.back(), 0);
+    for (std::size_t w = 0; w < m_windows.size(); ++w) {
+        if (owner[w] == s.m_pids.size()) continue;
+        s.m_windows[counts[owner[w]]++] = m_windows[w].second;
+    }
+
+    m_windows.clear();
+    return std::exchange(m_snapshot, std::make_unique<ProcessSnapshot>());
+}
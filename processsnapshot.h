@@ -0,0 +1,66 @@
+#ifndef PROCESSSNAPSHOT_H
+#define PROCESSSNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "snapshotpublisher.h"
+
+// Immutable view of running processes and their top-level windows, stored as
+// flat parallel arrays: names live in one string pool and each process's
+// windows are a contiguous range of one handle array. Build it with
+// ProcessSnapshotBuilder, share it through ProcessSnapshotPublisher.
+class ProcessSnapshot {
+public:
+    using Pid = std::uint32_t;
+    using WindowHandle = std::uintptr_t; // HWND on Windows
+
+    struct WindowRange {
+        const WindowHandle* first;
+        const WindowHandle* last;
+        const WindowHandle* begin() const { return first; }
+        const WindowHandle* end() const { return last; }
+        bool empty() const { return first == last; }
+    };
+
+    std::size_t size() const { return m_pids.size(); }
+    bool isEmpty() const { return m_pids.empty(); }
+
+    Pid pid(std::size_t i) const { return m_pids[i]; }
+    Pid parentPid(std::size_t i) const { return m_parentPids[i]; }
+    std::u16string_view name(std::size_t i) const {
+        return std::u16string_view(m_namePool).substr(m_nameOffsets[i], m_nameOffsets[i + 1] - m_nameOffsets[i]);
+    }
+    WindowRange windows(std::size_t i) const {
+        return { m_windows.data() + m_windowOffsets[i], m_windows.data() + m_windowOffsets[i + 1] };
+    }
+
+private:
+    friend class ProcessSnapshotBuilder;
+
+    std::vector<Pid> m_pids;
+    std::vector<Pid> m_parentPids;
+    std::vector<std::uint32_t> m_nameOffsets{0};   // size() + 1 entries into m_namePool
+    std::u16string m_namePool;
+    std::vector<std::uint32_t> m_windowOffsets{0}; // size() + 1 entries into m_windows
+    std::vector<WindowHandle> m_windows;
+};
+
+// Collects processes and windows in any order, then packs them into a snapshot
+class ProcessSnapshotBuilder {
+public:
+    void addProcess(ProcessSnapshot::Pid pid, ProcessSnapshot::Pid parentPid, std::u16string_view name);
+    // Windows of processes that were never added are dropped by build()
+    void addWindow(ProcessSnapshot::Pid pid, ProcessSnapshot::WindowHandle window);
+
+    std::unique_ptr<ProcessSnapshot> build();
+
+private:
+    std::unique_ptr<ProcessSnapshot> m_snapshot = std::make_unique<ProcessSnapshot>();
+    std::vector<std::pair<ProcessSnapshot::Pid, ProcessSnapshot::WindowHandle>> m_windows;
+};
+
+using ProcessSnapshotPublisher = SnapshotPublisher<ProcessSnapshot>;
+
+#endif // PROCESSSNAPSHOT_H
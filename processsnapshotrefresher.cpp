@@ -0,0 +1,39 @@
+#include "processsnapshotrefresher.h"
+
+ProcessSnapshotRefresher::ProcessSnapshotRefresher(PlatformBackend &backend, ProcessSnapshotPublisher &publisher,
+                                                   std::chrono::milliseconds interval)
+    : m_backend(backend)
+    , m_publisher(publisher)
+    , m_interval(interval)
+    , m_thread([this] { run(); })
+{
+}
+
+ProcessSnapshotRefresher::~ProcessSnapshotRefresher() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    m_thread.join();
+}
+
+void ProcessSnapshotRefresher::refreshNow() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_requested = true;
+    }
+    m_wake.notify_all();
+}
+
+void ProcessSnapshotRefresher::run() {
+    for (;;) {
+        // Never blocks on readers, see SnapshotPublisher
+        m_publisher.publish(m_backend.captureProcesses());
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_wake.wait_for(lock, m_interval, [this] { return m_stopping || m_requested; });
+        if (m_stopping) return;
+        m_requested = false;
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef PROCESSSNAPSHOTREFRESHER_H
+#define PROCESSSNAPSHOTREFRESHER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "platformbackend.h"
+#include "processsnapshot.h"
+
+// The one writer of a ProcessSnapshotPublisher: captures every process and
+// window on its own thread and publishes the result, once right away and
+// then every interval. Readers (hotkeys, the process picker) never capture
+// themselves, so the GUI thread never pays for a full process walk.
+class ProcessSnapshotRefresher {
+public:
+    ProcessSnapshotRefresher(PlatformBackend &backend, ProcessSnapshotPublisher &publisher,
+                             std::chrono::milliseconds interval = std::chrono::milliseconds(2000));
+    ~ProcessSnapshotRefresher();
+
+    ProcessSnapshotRefresher(const ProcessSnapshotRefresher&) = delete;
+    ProcessSnapshotRefresher& operator=(const ProcessSnapshotRefresher&) = delete;
+
+    // Returns immediately; the next capture starts without waiting out the interval
+    void refreshNow();
+
+private:
+    void run();
+
+    PlatformBackend &m_backend;
+    ProcessSnapshotPublisher &m_publisher;
+    const std::chrono::milliseconds m_interval;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_requested = false;
+    bool m_stopping = false;
+    std::thread m_thread;
+};
+
+#endif // PROCESSSNAPSHOTREFRESHER_H
@@ -0,0 +1,130 @@
+#ifndef SNAPSHOTPUBLISHER_H
+#define SNAPSHOTPUBLISHER_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// RCU-style publication of immutable snapshots. Readers pin the current
+// snapshot with two atomic increments and never block or allocate. Writers
+// swap in a new snapshot atomically and never wait for readers either: the
+// previous snapshot goes on a retire list and is deleted by a later
+// publish() or collect() once both reader counters have been seen at zero
+// after the swap. New readers pile onto the counter of the current epoch
+// while the other drains; the epoch flips once the idle one has been seen
+// at zero. Writers are serialized among
+// themselves. Guards are meant to be short-lived: the counters can't tell
+// snapshots apart, so a guard held across publishes keeps everything retired
+// meanwhile alive too.
+template <typename T>
+class SnapshotPublisher {
+    struct alignas(64) ReaderCounter {
+        std::atomic<int> count{0};
+    };
+
+public:
+    class ReadGuard {
+    public:
+        ReadGuard(ReadGuard&& other) noexcept
+            : m_counter(other.m_counter), m_snapshot(other.m_snapshot) {
+            other.m_counter = nullptr;
+            other.m_snapshot = nullptr;
+        }
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+        ReadGuard& operator=(ReadGuard&&) = delete;
+
+        ~ReadGuard() {
+            if (m_counter) m_counter->count.fetch_sub(1, std::memory_order_release);
+        }
+
+        const T* get() const { return m_snapshot; }
+        const T& operator*() const { return *m_snapshot; }
+        const T* operator->() const { return m_snapshot; }
+
+    private:
+        friend class SnapshotPublisher;
+        ReadGuard(ReaderCounter* counter, const T* snapshot)
+            : m_counter(counter), m_snapshot(snapshot) {}
+
+        ReaderCounter* m_counter;
+        const T* m_snapshot;
+    };
+
+    SnapshotPublisher() : m_current(new T()) {}
+    explicit SnapshotPublisher(std::unique_ptr<T> initial) : m_current(initial.release()) {}
+    ~SnapshotPublisher() {
+        for (const Retired &retired : m_retired) delete retired.snapshot;
+        delete m_current.load();
+    }
+
+    SnapshotPublisher(const SnapshotPublisher&) = delete;
+    SnapshotPublisher& operator=(const SnapshotPublisher&) = delete;
+
+    // Never null. The snapshot stays alive until the guard is destroyed.
+    ReadGuard read() const {
+        // seq_cst on purpose: collect() relies on a single total order of
+        // "increment counter, load pointer" against "swap pointer, check counter"
+        ReaderCounter& counter = m_readers[m_epoch.load() & 1];
+        counter.count.fetch_add(1);
+        return ReadGuard(&counter, m_current.load());
+    }
+
+    // Returns at once; the previous snapshot is freed once its readers are done
+    void publish(std::unique_ptr<T> snapshot) {
+        std::lock_guard<std::mutex> lock(m_writerMutex);
+        const T* old = m_current.exchange(snapshot.release());
+        m_retired.push_back({ old, { false, false } });
+        collectLocked();
+    }
+
+    // Frees retired snapshots nobody can still be reading. Returns how many
+    // are left waiting for readers.
+    std::size_t collect() {
+        std::lock_guard<std::mutex> lock(m_writerMutex);
+        return collectLocked();
+    }
+
+private:
+    struct Retired {
+        const T* snapshot;
+        bool drained[2];
+    };
+
+    std::size_t collectLocked() {
+        // A reader that got a retired pointer incremented its counter before
+        // the swap (seq_cst), so a zero seen after the swap means it is gone.
+        // Which epoch the reader picked doesn't matter.
+        bool zero[2];
+        for (int i = 0; i < 2; ++i) zero[i] = m_readers[i].count.load() == 0;
+
+        const unsigned idle = ~m_epoch.load() & 1;
+        bool idleDrained = true;
+        std::size_t kept = 0;
+        for (Retired &retired : m_retired) {
+            for (int i = 0; i < 2; ++i) retired.drained[i] = retired.drained[i] || zero[i];
+            if (retired.drained[0] && retired.drained[1]) {
+                delete retired.snapshot;
+            } else {
+                idleDrained = idleDrained && retired.drained[idle];
+                m_retired[kept++] = retired;
+            }
+        }
+        m_retired.resize(kept);
+
+        // Only the counter new readers aren't using can be relied on to
+        // reach zero. Once it has, swap roles so the other one drains too.
+        if (kept > 0 && idleDrained) m_epoch.fetch_add(1);
+        return kept;
+    }
+
+    mutable ReaderCounter m_readers[2];
+    std::atomic<unsigned> m_epoch{0};
+    std::atomic<const T*> m_current;
+    std::mutex m_writerMutex;
+    std::vector<Retired> m_retired; // Guarded by m_writerMutex
+};
+
+#endif // SNAPSHOTPUBLISHER_H
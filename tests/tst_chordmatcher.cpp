@@ -0,0 +1,173 @@
+#include <QtTest>
+#include <QRandomGenerator>
+#include "../chordmatcher.h"
+
+namespace {
+
+// Arbitrary modifier bits, the matcher doesn't interpret them
+constexpr std::uint16_t Ctrl = 0x2;
+constexpr std::uint16_t Shift = 0x4;
+
+ChordMatcher::Chord ctrl(char key) { return ChordMatcher::makeChord(Ctrl, key); }
+
+// Deterministic stream of chords, most of which match nothing
+std::vector<ChordMatcher::Chord> syntheticStream(int size) {
+    QRandomGenerator rng(42);
+    std::vector<ChordMatcher::Chord> stream;
+    stream.reserve(size);
+    for (int i = 0; i < size; ++i) {
+        std::uint16_t mods = std::uint16_t(rng.bounded(16));
+        std::uint16_t key = std::uint16_t('A' + rng.bounded(26));
+        stream.push_back(ChordMatcher::makeChord(mods, key));
+    }
+    return stream;
+}
+
+} // namespace
+
+class TestChordMatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testSingleChord() {
+        ChordMatcher m;
+        QVERIFY(m.addSequence({ ctrl('G') }, 1));
+        QCOMPARE(m.feed(ctrl('H')), ChordMatcher::NoMatch);
+        QCOMPARE(m.feed(ctrl('G')), 1);
+        QCOMPARE(m.feed(ctrl('G')), 1);
+    }
+
+    void testMultiChord() {
+        ChordMatcher m;
+        QVERIFY(m.addSequence({ ctrl('K'), ctrl('M') }, 1));
+        QVERIFY(m.addSequence({ ctrl('K'), ctrl('R') }, 2));
+
+        QCOMPARE(m.feed(ctrl('K')), ChordMatcher::NoMatch);
+        QCOMPARE(m.feed(ctrl('M')), 1);
+        QCOMPARE(m.feed(ctrl('K')), ChordMatcher::NoMatch);
+        QCOMPARE(m.feed(ctrl('R')), 2);
+
+        // Second chord alone does nothing
+        QCOMPARE(m.feed(ctrl('M')), ChordMatcher::NoMatch);
+    }
+
+    void testModifiersMustMatch() {
+        ChordMatcher m;
+        QVERIFY(m.addSequence({ ctrl('K'), ctrl('M') }, 1));
+        QCOMPARE(m.feed(ctrl('K')), ChordMatcher::NoMatch);
+        QCOMPARE(m.feed(ChordMatcher::makeChord(Ctrl | Shift, 'M')), ChordMatcher::NoMatch);
+        QCOMPARE(m.feed(ctrl('M')), ChordMatcher::NoMatch);
+    }
+
+    void testBrokenPrefixRestarts() {
+        ChordMatcher m;
+        QVERIFY(m.addSequence({ ctrl('K'), ctrl('M') }, 1));
+
+        // Auto-repeat of the first chord must not lose the partial match
+        QCOMPARE(m.feed(ctrl('K')), ChordMatcher::NoMatch);
+        QCOMPARE(m.feed(ctrl('K')), ChordMatcher::NoMatch);
+        QCOMPARE(m.feed(ctrl('M')), 1);
+
+        QCOMPARE(m.feed(ctrl('K')), ChordMatcher::NoMatch);
+        QCOMPARE(m.feed(ctrl('X')), ChordMatcher::NoMatch);
+        QCOMPARE(m.feed(ctrl('M')), ChordMatcher::NoMatch);
+    }
+
+    void testRepeatedChordSequence() {
+        ChordMatcher m;
+        QVERIFY(m.addSequence({ ctrl('K'), ctrl('K'), ctrl('M') }, 1));
+
+        QCOMPARE(m.feed(ctrl('K')), ChordMatcher::NoMatch);
+        QCOMPARE(m.feed(ctrl('K')), ChordMatcher::NoMatch);
+        QCOMPARE(m.feed(ctrl('M')), 1);
+
+        // Auto-repeat overshoots the repeated chord
+        QCOMPARE(m.feed(ctrl('K')), ChordMatcher::NoMatch);
+        QCOMPARE(m.feed(ctrl('K')), ChordMatcher::NoMatch);
+        QCOMPARE(m.feed(ctrl('K')), ChordMatcher::NoMatch);
+        QCOMPARE(m.feed(ctrl('K')), ChordMatcher::NoMatch);
+        QCOMPARE(m.feed(ctrl('M')), 1);
+    }
+
+    void testOverlappingPartialMatch() {
+        // A broken match whose tail is a new prefix must not lose that tail
+        ChordMatcher m;
+        QVERIFY(m.addSequence({ ctrl('A'), ctrl('B'), ctrl('A'), ctrl('C') }, 1));
+
+        for (char key : { 'A', 'B', 'A', 'B', 'A' }) {
+            QCOMPARE(m.feed(ctrl(key)), ChordMatcher::NoMatch);
+        }
+        QCOMPARE(m.feed(ctrl('C')), 1);
+    }
+
+    void testTimeout() {
+        ChordMatcher m;
+        m.setChordTimeout(1000);
+        QVERIFY(m.addSequence({ ctrl('K'), ctrl('M') }, 1));
+
+        QCOMPARE(m.feed(ctrl('K'), 100), ChordMatcher::NoMatch);
+        QCOMPARE(m.feed(ctrl('M'), 1100), 1);
+
+        QCOMPARE(m.feed(ctrl('K'), 2000), ChordMatcher::NoMatch);
+        QCOMPARE(m.feed(ctrl('M'), 3001), ChordMatcher::NoMatch);
+    }
+
+    void testConflictsRejected() {
+        ChordMatcher m;
+        QVERIFY(m.addSequence({ ctrl('K'), ctrl('M') }, 1));
+        QVERIFY(!m.addSequence({ ctrl('K'), ctrl('M') }, 2));            // duplicate
+        QVERIFY(!m.addSequence({ ctrl('K') }, 2));                       // prefix of existing
+        QVERIFY(!m.addSequence({ ctrl('K'), ctrl('M'), ctrl('X') }, 2)); // existing is prefix
+        QVERIFY(!m.addSequence({ ctrl('X'), ctrl('K'), ctrl('M') }, 2)); // existing is suffix
+        QVERIFY(!m.addSequence({ ctrl('M') }, 2));                       // infix of existing
+        QVERIFY(!m.addSequence({}, 2));
+
+        // Rejected sequences leave the matcher as it was
+        QCOMPARE(m.feed(ctrl('K')), ChordMatcher::NoMatch);
+        QCOMPARE(m.feed(ctrl('M')), 1);
+    }
+
+    void testClear() {
+        ChordMatcher m;
+        QVERIFY(m.isEmpty());
+        QVERIFY(m.addSequence({ ctrl('K'), ctrl('M') }, 1));
+        QVERIFY(!m.isEmpty());
+        m.clear();
+        QVERIFY(m.isEmpty());
+        QCOMPARE(m.feed(ctrl('K')), ChordMatcher::NoMatch);
+        QCOMPARE(m.feed(ctrl('M')), ChordMatcher::NoMatch);
+    }
+
+    void testManySequences() {
+        // Forces the edge table to grow several times
+        ChordMatcher m;
+        for (int i = 0; i < 100; ++i) {
+            QVERIFY(m.addSequence({ ChordMatcher::makeChord(Ctrl, std::uint16_t(i)),
+                                    ChordMatcher::makeChord(Shift, std::uint16_t(i)) }, i));
+        }
+        for (int i = 0; i < 100; ++i) {
+            QCOMPARE(m.feed(ChordMatcher::makeChord(Ctrl, std::uint16_t(i))), ChordMatcher::NoMatch);
+            QCOMPARE(m.feed(ChordMatcher::makeChord(Shift, std::uint16_t(i))), i);
+        }
+    }
+
+    void benchmarkFeed() {
+        ChordMatcher m;
+        QVERIFY(m.addSequence({ ctrl('K'), ctrl('M') }, 1));
+        QVERIFY(m.addSequence({ ctrl('K'), ctrl('R') }, 2));
+        QVERIFY(m.addSequence({ ctrl('G') }, 3));
+
+        const auto stream = syntheticStream(4096);
+        int matches = 0;
+        QBENCHMARK {
+            for (ChordMatcher::Chord c : stream) {
+                matches += m.feed(c) != ChordMatcher::NoMatch;
+            }
+        }
+        QVERIFY(matches >= 0);
+    }
+};
+
+QTEST_APPLESS_MAIN(TestChordMatcher)
+#include "tst_chordmatcher.moc"
@@ -0,0 +1,93 @@
+#include <QtTest>
+#include "../hotkeybinding.h"
+
+namespace {
+
+HotkeyBinding binding(int id, std::initializer_list<Qt::Key> keys) {
+    HotkeyBinding b;
+    b.id = id;
+    for (Qt::Key key : keys) b.chords << QKeyCombination(Qt::ControlModifier, key);
+    return b;
+}
+
+} // namespace
+
+class TestHotkeyBinding : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testShape() {
+        QVERIFY(binding(1, {}).isEmpty());
+        QVERIFY(!binding(1, { Qt::Key_G }).isMultiChord());
+        QVERIFY(binding(1, { Qt::Key_K, Qt::Key_M }).isMultiChord());
+    }
+
+    void testDistinctBindingsDontConflict() {
+        QVERIFY(!binding(1, { Qt::Key_G }).conflictsWith(binding(2, { Qt::Key_H })));
+        QVERIFY(!binding(1, { Qt::Key_K, Qt::Key_M }).conflictsWith(binding(2, { Qt::Key_K, Qt::Key_R })));
+        QVERIFY(!binding(1, { Qt::Key_K, Qt::Key_M }).conflictsWith(binding(2, { Qt::Key_M, Qt::Key_K })));
+    }
+
+    void testEqualBindingsConflict() {
+        QVERIFY(binding(1, { Qt::Key_G }).conflictsWith(binding(2, { Qt::Key_G })));
+        QVERIFY(binding(1, { Qt::Key_K, Qt::Key_M }).conflictsWith(binding(2, { Qt::Key_K, Qt::Key_M })));
+    }
+
+    void testPrefixConflictsBothWays() {
+        QVERIFY(binding(1, { Qt::Key_K }).conflictsWith(binding(2, { Qt::Key_K, Qt::Key_M })));
+        QVERIFY(binding(1, { Qt::Key_K, Qt::Key_M }).conflictsWith(binding(2, { Qt::Key_K })));
+    }
+
+    void testContainedConflicts() {
+        // Ctrl+M would fire before Ctrl+K, Ctrl+M could ever complete
+        QVERIFY(binding(1, { Qt::Key_K, Qt::Key_M }).conflictsWith(binding(2, { Qt::Key_M })));
+        QVERIFY(binding(1, { Qt::Key_M }).conflictsWith(binding(2, { Qt::Key_K, Qt::Key_M })));
+        QVERIFY(binding(1, { Qt::Key_A, Qt::Key_K, Qt::Key_B }).conflictsWith(binding(2, { Qt::Key_K })));
+    }
+
+    void testFromPortableText() {
+        HotkeyBinding single = HotkeyBinding::fromPortableText(1, u"Ctrl+G");
+        QCOMPARE(single.id, 1);
+        QCOMPARE(single.chords, QList<QKeyCombination>({ QKeyCombination(Qt::ControlModifier, Qt::Key_G) }));
+
+        HotkeyBinding sequence = HotkeyBinding::fromPortableText(2, u"Ctrl+Shift+K, Alt+F4");
+        QCOMPARE(sequence.chords, QList<QKeyCombination>({
+            QKeyCombination(Qt::ControlModifier | Qt::ShiftModifier, Qt::Key_K),
+            QKeyCombination(Qt::AltModifier, Qt::Key_F4) }));
+
+        // Modifier order and case don't matter
+        QCOMPARE(HotkeyBinding::fromPortableText(3, u"shift+meta+ctrl+alt+esc").chords,
+                 QList<QKeyCombination>({ QKeyCombination(Qt::ShiftModifier | Qt::MetaModifier | Qt::ControlModifier
+                                                          | Qt::AltModifier, Qt::Key_Escape) }));
+        QCOMPARE(HotkeyBinding::fromPortableText(4, u"Del").chords,
+                 QList<QKeyCombination>({ QKeyCombination(Qt::NoModifier, Qt::Key_Delete) }));
+        QCOMPARE(HotkeyBinding::fromPortableText(5, u"Ctrl+7").chords,
+                 QList<QKeyCombination>({ QKeyCombination(Qt::ControlModifier, Qt::Key_7) }));
+    }
+
+    void testFromPortableTextRejectsUnknownKeys() {
+        QVERIFY(HotkeyBinding::fromPortableText(1, u"").isEmpty());
+        QVERIFY(HotkeyBinding::fromPortableText(1, u"Ctrl+PgUp").isEmpty());
+        QVERIFY(HotkeyBinding::fromPortableText(1, u"Hyper+G").isEmpty());
+        QVERIFY(!HotkeyBinding::fromPortableText(1, u"F12").isEmpty());
+        QVERIFY(HotkeyBinding::fromPortableText(1, u"F13").isEmpty());    // No virtual key mapping
+        QVERIFY(HotkeyBinding::fromPortableText(1, u"Ctrl+F0").isEmpty());
+        QVERIFY(HotkeyBinding::fromPortableText(1, u"Ctrl+K, Ctrl+").isEmpty()); // One bad chord spoils it
+        QCOMPARE(HotkeyBinding::fromPortableText(7, u"Ctrl+PgUp").id, 7);
+    }
+
+    void testModifiersMatter() {
+        HotkeyBinding shifted;
+        shifted.chords << QKeyCombination(Qt::ControlModifier | Qt::ShiftModifier, Qt::Key_G);
+        QVERIFY(!binding(1, { Qt::Key_G }).conflictsWith(shifted));
+    }
+
+    void testEmptyNeverConflicts() {
+        QVERIFY(!binding(1, {}).conflictsWith(binding(2, { Qt::Key_G })));
+        QVERIFY(!binding(1, {}).conflictsWith(binding(2, {})));
+    }
+};
+
+QTEST_APPLESS_MAIN(TestHotkeyBinding)
+#include "tst_hotkeybinding.moc"
@@ -8,29 +8,36 @@ class TestKeyMapping : public QObject
 private slots:
     void testLetters() {
         // In WinAPI, 'A' is just 0x41
-        QCOMPARE(qtKeyToWinVK(Qt::Key_A), (DWORD)'A');
-        QCOMPARE(qtKeyToWinVK(Qt::Key_Z), (DWORD)'Z');
+        QCOMPARE(qtKeyToWinVK(Qt::Key_A), (std::uint32_t)'A');
+        QCOMPARE(qtKeyToWinVK(Qt::Key_Z), (std::uint32_t)'Z');
     }
 
     void testNumbers() {
-        QCOMPARE(qtKeyToWinVK(Qt::Key_0), (DWORD)'0');
-        QCOMPARE(qtKeyToWinVK(Qt::Key_9), (DWORD)'9');
+        QCOMPARE(qtKeyToWinVK(Qt::Key_0), (std::uint32_t)'0');
+        QCOMPARE(qtKeyToWinVK(Qt::Key_9), (std::uint32_t)'9');
     }
 
     void testFunctionKeys() {
-        // VK_F1 is 0x70
-        QCOMPARE(qtKeyToWinVK(Qt::Key_F1), (DWORD)VK_F1);
-        QCOMPARE(qtKeyToWinVK(Qt::Key_F12), (DWORD)VK_F12);
+        // VK_F1 is 0x70, VK_F12 is 0x7B
+        QCOMPARE(qtKeyToWinVK(Qt::Key_F1), (std::uint32_t)0x70);
+        QCOMPARE(qtKeyToWinVK(Qt::Key_F12), (std::uint32_t)0x7B);
     }
 
     void testModifiersIgnored() {
         // The function should strip Ctrl/Alt/Shift and return just the key
-        QCOMPARE(qtKeyToWinVK(QKeyCombination(Qt::ControlModifier, Qt::Key_A).toCombined()), (DWORD)'A');
+        QCOMPARE(qtKeyToWinVK(QKeyCombination(Qt::ControlModifier, Qt::Key_A).toCombined()), (std::uint32_t)'A');
+    }
+
+    void testModifiers() {
+        // MOD_ALT 0x1, MOD_CONTROL 0x2, MOD_SHIFT 0x4, MOD_WIN 0x8
+        QCOMPARE(qtModifiersToWinMod(Qt::NoModifier), (std::uint32_t)0);
+        QCOMPARE(qtModifiersToWinMod(Qt::ControlModifier), (std::uint32_t)0x2);
+        QCOMPARE(qtModifiersToWinMod(Qt::AltModifier | Qt::ShiftModifier | Qt::MetaModifier), (std::uint32_t)0xD);
     }
 
     void testUnknownKey() {
         // Qt::Key_Exclam -> Should return 0 (not mapped in your switch)
-        QCOMPARE(qtKeyToWinVK(Qt::Key_Exclam), (DWORD)0);
+        QCOMPARE(qtKeyToWinVK(Qt::Key_Exclam), (std::uint32_t)0);
     }
 };
 
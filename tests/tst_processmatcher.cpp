@@ -0,0 +1,71 @@
+#include <QtTest>
+#include "../processmatcher.h"
+
+namespace {
+
+std::unique_ptr<ProcessSnapshot> sampleSnapshot() {
+    ProcessSnapshotBuilder builder;
+    builder.addProcess(10, 1, u"Notepad.EXE");
+    builder.addProcess(20, 1, u"notepad.exe");
+    builder.addProcess(30, 1, u"chrome.exe");
+    builder.addProcess(40, 1, u"notepad.exe.bak");
+    builder.addWindow(10, 0x100);
+    builder.addWindow(20, 0x200);
+    builder.addWindow(20, 0x201);
+    builder.addWindow(30, 0x300);
+    builder.addWindow(40, 0x400);
+    return builder.build();
+}
+
+} // namespace
+
+class TestProcessMatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testCaseInsensitive() {
+        ProcessMatcher matcher(QStringList{ "NOTEPAD.exe" });
+        QVERIFY(matcher.matches(u"notepad.exe"));
+        QVERIFY(matcher.matches(u"Notepad.EXE"));
+        QVERIFY(!matcher.matches(u"notepad"));
+        QVERIFY(!matcher.matches(u"notepad.exe.bak"));
+    }
+
+    void testWindowsOfAllInstances() {
+        auto snapshot = sampleSnapshot();
+        auto windows = ProcessMatcher(QStringList{ "notepad.exe" }).windows(*snapshot);
+        QCOMPARE(windows, std::vector<ProcessSnapshot::WindowHandle>({ 0x100, 0x200, 0x201 }));
+    }
+
+    void testSeveralNames() {
+        auto snapshot = sampleSnapshot();
+        auto windows = ProcessMatcher(QStringList{ "chrome.exe", "notepad.exe.bak" }).windows(*snapshot);
+        QCOMPARE(windows, std::vector<ProcessSnapshot::WindowHandle>({ 0x300, 0x400 }));
+    }
+
+    void testPids() {
+        // Processes without windows count too, they may have opened one since
+        ProcessSnapshotBuilder builder;
+        builder.addProcess(10, 1, u"notepad.exe");
+        builder.addProcess(20, 1, u"chrome.exe");
+        builder.addProcess(30, 1, u"NOTEPAD.EXE");
+        builder.addWindow(30, 0x300);
+        auto snapshot = builder.build();
+
+        QCOMPARE(ProcessMatcher(QStringList{ "notepad.exe" }).pids(*snapshot),
+                 std::vector<ProcessSnapshot::Pid>({ 10, 30 }));
+        QVERIFY(ProcessMatcher(QStringList{}).pids(*snapshot).empty());
+    }
+
+    void testNoMatch() {
+        auto snapshot = sampleSnapshot();
+        QVERIFY(ProcessMatcher(QStringList{}).isEmpty());
+        QVERIFY(ProcessMatcher(QStringList{}).windows(*snapshot).empty());
+        QVERIFY(ProcessMatcher(QStringList{ "explorer.exe" }).windows(*snapshot).empty());
+        QVERIFY(ProcessMatcher(QStringList{ "notepad.exe" }).windows(ProcessSnapshot()).empty());
+    }
+};
+
+QTEST_APPLESS_MAIN(TestProcessMatcher)
+#include "tst_processmatcher.moc"
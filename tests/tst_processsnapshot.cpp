@@ -0,0 +1,197 @@
+#include <QtTest>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "../processsnapshot.h"
+
+namespace {
+
+// Payload that checks its own integrity, so a reader touching a freed or
+// half-built snapshot is caught (and reported loudly under ASan)
+struct Payload {
+    static constexpr std::uint32_t Alive = 0xA11FEu;
+    static constexpr std::uint32_t Dead = 0xDEADu;
+    static std::atomic<int> liveCount;
+
+    std::uint32_t magic = Alive;
+    std::uint64_t generation = 0;
+    std::vector<std::uint64_t> values;
+
+    Payload() { ++liveCount; }
+    explicit Payload(std::uint64_t gen) : generation(gen), values(64, gen) { ++liveCount; }
+    ~Payload() {
+        magic = Dead;
+        std::fill(values.begin(), values.end(), ~generation);
+        --liveCount;
+    }
+
+    bool isConsistent() const {
+        if (magic != Alive) return false;
+        for (std::uint64_t v : values) {
+            if (v != generation) return false;
+        }
+        return true;
+    }
+};
+
+std::atomic<int> Payload::liveCount{0};
+
+} // namespace
+
+class TestProcessSnapshot : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testEmptySnapshot() {
+        ProcessSnapshotPublisher publisher;
+        auto snapshot = publisher.read();
+        QVERIFY(snapshot.get() != nullptr);
+        QVERIFY(snapshot->isEmpty());
+        QCOMPARE(snapshot->size(), std::size_t(0));
+    }
+
+    void testBuilder() {
+        ProcessSnapshotBuilder builder;
+        builder.addProcess(10, 1, u"explorer.exe");
+        builder.addProcess(20, 10, u"notepad.exe");
+        builder.addProcess(30, 10, u"");
+
+        // Windows arrive interleaved, as EnumWindows reports them
+        builder.addWindow(20, 0x200);
+        builder.addWindow(10, 0x100);
+        builder.addWindow(99, 0x999); // Unknown process, dropped
+        builder.addWindow(20, 0x201);
+
+        auto snapshot = builder.build();
+        QCOMPARE(snapshot->size(), std::size_t(3));
+
+        QCOMPARE(snapshot->pid(1), ProcessSnapshot::Pid(20));
+        QCOMPARE(snapshot->parentPid(1), ProcessSnapshot::Pid(10));
+        QVERIFY(snapshot->name(0) == u"explorer.exe");
+        QVERIFY(snapshot->name(1) == u"notepad.exe");
+        QVERIFY(snapshot->name(2).empty());
+
+        std::vector<ProcessSnapshot::WindowHandle> explorer(snapshot->windows(0).begin(), snapshot->windows(0).end());
+        std::vector<ProcessSnapshot::WindowHandle> notepad(snapshot->windows(1).begin(), snapshot->windows(1).end());
+        QCOMPARE(explorer, std::vector<ProcessSnapshot::WindowHandle>({ 0x100 }));
+        QCOMPARE(notepad, std::vector<ProcessSnapshot::WindowHandle>({ 0x200, 0x201 }));
+        QVERIFY(snapshot->windows(2).empty());
+
+        // Builder is reusable after build()
+        builder.addProcess(40, 0, u"a.exe");
+        QCOMPARE(builder.build()->size(), std::size_t(1));
+    }
+
+    void testPublishReplaces() {
+        ProcessSnapshotPublisher publisher;
+        ProcessSnapshotBuilder builder;
+        builder.addProcess(1, 0, u"first.exe");
+        publisher.publish(builder.build());
+        QVERIFY(publisher.read()->name(0) == u"first.exe");
+
+        builder.addProcess(2, 0, u"second.exe");
+        publisher.publish(builder.build());
+        QVERIFY(publisher.read()->name(0) == u"second.exe");
+    }
+
+    void testGuardKeepsSnapshotAlive() {
+        QCOMPARE(Payload::liveCount.load(), 0);
+        {
+            SnapshotPublisher<Payload> publisher(std::make_unique<Payload>(1));
+            {
+                auto guard = publisher.read();
+
+                // Publishing doesn't wait for the reader, even on its own thread
+                publisher.publish(std::make_unique<Payload>(2));
+                QCOMPARE(publisher.read()->generation, std::uint64_t(2));
+
+                // ...but generation 1 stays alive until the guard is gone
+                QCOMPARE(publisher.collect(), std::size_t(1));
+                QCOMPARE(Payload::liveCount.load(), 2);
+                QVERIFY(guard->isConsistent());
+                QCOMPARE(guard->generation, std::uint64_t(1));
+            }
+            QCOMPARE(publisher.collect(), std::size_t(0));
+            QCOMPARE(Payload::liveCount.load(), 1);
+
+            // Without readers every publish frees its predecessor right away
+            for (std::uint64_t gen = 3; gen < 10; ++gen) {
+                publisher.publish(std::make_unique<Payload>(gen));
+                QCOMPARE(Payload::liveCount.load(), 1);
+            }
+        }
+        QCOMPARE(Payload::liveCount.load(), 0);
+    }
+
+    void testConcurrentReadersAndWriters() {
+        const int readerCount = qMax(2, int(std::thread::hardware_concurrency()) - 2);
+        const int writerCount = 2;
+        // Time-bounded so the run length doesn't depend on the core count
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+
+        std::atomic<int> failures{0};
+        std::atomic<std::uint64_t> reads{0};
+        std::atomic<bool> stop{false};
+        std::atomic<std::uint64_t> nextGeneration{1};
+        {
+            SnapshotPublisher<Payload> publisher(std::make_unique<Payload>(0));
+
+            std::vector<std::thread> threads;
+            for (int r = 0; r < readerCount; ++r) {
+                threads.emplace_back([&] {
+                    std::uint64_t local = 0;
+                    while (!stop.load(std::memory_order_relaxed)) {
+                        auto guard = publisher.read();
+                        if (!guard->isConsistent()) ++failures;
+                        ++local;
+                    }
+                    reads += local;
+                });
+            }
+
+            std::vector<std::thread> writers;
+            for (int w = 0; w < writerCount; ++w) {
+                writers.emplace_back([&] {
+                    while (std::chrono::steady_clock::now() < deadline) {
+                        publisher.publish(std::make_unique<Payload>(nextGeneration++));
+                    }
+                });
+            }
+            for (auto &t : writers) t.join();
+            stop = true;
+            for (auto &t : threads) t.join();
+
+            QCOMPARE(publisher.collect(), std::size_t(0));
+            QCOMPARE(Payload::liveCount.load(), 1);
+        }
+
+        qInfo("%d readers, %llu reads, %llu publishes", readerCount,
+              static_cast<unsigned long long>(reads.load()),
+              static_cast<unsigned long long>(nextGeneration.load() - 1));
+        QCOMPARE(failures.load(), 0);
+        QVERIFY(reads.load() > 0);
+        QVERIFY(nextGeneration.load() > 1);
+        QCOMPARE(Payload::liveCount.load(), 0);
+    }
+
+    void benchmarkRead() {
+        ProcessSnapshotBuilder builder;
+        for (ProcessSnapshot::Pid pid = 1; pid <= 300; ++pid) {
+            builder.addProcess(pid, 0, u"process.exe");
+            builder.addWindow(pid, pid * 16);
+        }
+        ProcessSnapshotPublisher publisher;
+        publisher.publish(builder.build());
+
+        std::size_t total = 0;
+        QBENCHMARK {
+            auto snapshot = publisher.read();
+            total += snapshot->size();
+        }
+        QVERIFY(total > 0);
+    }
+};
+
+QTEST_APPLESS_MAIN(TestProcessSnapshot)
+#include "tst_processsnapshot.moc"
@@ -0,0 +1,90 @@
+#include <QtTest>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "../processsnapshotrefresher.h"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// Each capture is one process whose pid counts the captures
+class CountingBackend : public PlatformBackend {
+public:
+    std::atomic<int> captures{0};
+
+    std::unique_ptr<ProcessSnapshot> captureProcesses() override {
+        ProcessSnapshotBuilder builder;
+        builder.addProcess(ProcessSnapshot::Pid(++captures), 0, u"app.exe");
+        return builder.build();
+    }
+    std::vector<ProcessSnapshot::WindowHandle> captureWindows(std::vector<ProcessSnapshot::Pid>) override { return {}; }
+    QString processImagePath(ProcessSnapshot::Pid) override { return QString(); }
+    void applyWindowAction(ProcessSnapshot::WindowHandle, WindowAction) override {}
+    WindowState windowState(ProcessSnapshot::WindowHandle) override { return WindowState::Gone; }
+    bool isResponding(ProcessSnapshot::WindowHandle) override { return true; }
+    bool registerHotkey(const HotkeyBinding &) override { return false; }
+    void unregisterHotkeys() override {}
+    bool setLaunchAtStartup(bool) override { return false; }
+};
+
+// Polls rather than sleeping a fixed time, so slow machines only take longer
+bool waitForPublished(const ProcessSnapshotPublisher &publisher, ProcessSnapshot::Pid atLeast) {
+    const auto giveUp = std::chrono::steady_clock::now() + 10s;
+    while (std::chrono::steady_clock::now() < giveUp) {
+        {
+            auto snapshot = publisher.read();
+            if (!snapshot->isEmpty() && snapshot->pid(0) >= atLeast) return true;
+        }
+        std::this_thread::sleep_for(1ms);
+    }
+    return false;
+}
+
+} // namespace
+
+class TestProcessSnapshotRefresher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testPublishesRightAway() {
+        CountingBackend backend;
+        ProcessSnapshotPublisher publisher;
+        ProcessSnapshotRefresher refresher(backend, publisher, 1h);
+        QVERIFY(waitForPublished(publisher, 1));
+    }
+
+    void testRefreshNowSkipsTheInterval() {
+        CountingBackend backend;
+        ProcessSnapshotPublisher publisher;
+        ProcessSnapshotRefresher refresher(backend, publisher, 1h);
+        QVERIFY(waitForPublished(publisher, 1));
+
+        refresher.refreshNow();
+        QVERIFY(waitForPublished(publisher, 2));
+    }
+
+    void testRefreshesPeriodically() {
+        CountingBackend backend;
+        ProcessSnapshotPublisher publisher;
+        ProcessSnapshotRefresher refresher(backend, publisher, 5ms);
+        QVERIFY(waitForPublished(publisher, 3));
+    }
+
+    void testStopsPromptly() {
+        // The destructor must not wait out the interval
+        CountingBackend backend;
+        ProcessSnapshotPublisher publisher;
+        {
+            ProcessSnapshotRefresher refresher(backend, publisher, 1h);
+            QVERIFY(waitForPublished(publisher, 1));
+        }
+        const int captures = backend.captures;
+        std::this_thread::sleep_for(10ms);
+        QCOMPARE(backend.captures.load(), captures);
+    }
+};
+
+QTEST_APPLESS_MAIN(TestProcessSnapshotRefresher)
+#include "tst_processsnapshotrefresher.moc"
@@ -0,0 +1,427 @@
+#include <QtTest>
+#include <algorithm>
+#include <future>
+#include <map>
+#include <mutex>
+#include "../windowactiondispatcher.h"
+
+using namespace std::chrono_literals;
+using Result = WindowActionOutcome::Result;
+
+namespace {
+
+// Window manager with scripted windows: each action takes effect after the
+// window's delay, unless the window is hung or refuses that action
+class SimulatedWindowManager : public WindowManager {
+public:
+    enum class Behavior {
+        Responsive,
+        Hung,              // Ignores everything and reports itself not responding
+        IgnoresEverything, // Ignores everything, but still responds
+        RefusesMinimize,   // Ignores minimize, honours hide and restore
+        IgnoresFirst,      // Drops the first action, honours the rest
+    };
+
+    void addWindow(ProcessSnapshot::WindowHandle handle, Behavior behavior = Behavior::Responsive,
+                   std::chrono::milliseconds delay = 0ms, WindowState initial = WindowState::Normal) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_windows[handle] = Window{ behavior, delay, initial, {}, {} };
+    }
+
+    void setBehavior(ProcessSnapshot::WindowHandle handle, Behavior behavior) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_windows[handle].behavior = behavior;
+    }
+
+    void closeWindow(ProcessSnapshot::WindowHandle handle) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_windows.erase(handle);
+    }
+
+    int issued(ProcessSnapshot::WindowHandle handle) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return int(m_windows[handle].log.size());
+    }
+
+    // Every action sent to the window, in order
+    std::vector<WindowAction> log(ProcessSnapshot::WindowHandle handle) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_windows[handle].log;
+    }
+
+    void applyWindowAction(ProcessSnapshot::WindowHandle handle, WindowAction action) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_windows.find(handle);
+        if (it == m_windows.end()) return;
+
+        Window &w = it->second;
+        w.log.push_back(action);
+        if (w.behavior == Behavior::Hung || w.behavior == Behavior::IgnoresEverything) return;
+        if (w.behavior == Behavior::RefusesMinimize && action == WindowAction::Minimize) return;
+        if (w.behavior == Behavior::IgnoresFirst && w.log.size() == 1) return;
+        w.pending.push_back({ std::chrono::steady_clock::now() + w.delay, targetState(action) });
+    }
+
+    WindowState windowState(ProcessSnapshot::WindowHandle handle) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_windows.find(handle);
+        if (it == m_windows.end()) return WindowState::Gone;
+
+        Window &w = it->second;
+        const auto now = std::chrono::steady_clock::now();
+        while (!w.pending.empty() && w.pending.front().first <= now) {
+            w.state = w.pending.front().second;
+            w.pending.erase(w.pending.begin());
+        }
+        return w.state;
+    }
+
+    bool isResponding(ProcessSnapshot::WindowHandle handle) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_windows.find(handle);
+        return it == m_windows.end() || it->second.behavior != Behavior::Hung;
+    }
+
+private:
+    struct Window {
+        Behavior behavior;
+        std::chrono::milliseconds delay;
+        WindowState state;
+        std::vector<std::pair<std::chrono::steady_clock::time_point, WindowState>> pending;
+        std::vector<WindowAction> log;
+    };
+
+    static WindowState targetState(WindowAction action) {
+        switch (action) {
+        case WindowAction::Minimize: return WindowState::Minimized;
+        case WindowAction::Restore:  return WindowState::Normal;
+        case WindowAction::Hide:     return WindowState::Hidden;
+        }
+        return WindowState::Normal;
+    }
+
+    std::mutex m_mutex;
+    std::map<ProcessSnapshot::WindowHandle, Window> m_windows;
+};
+
+WindowDispatchOptions fastOptions() {
+    WindowDispatchOptions options;
+    options.workers = 4;
+    options.batchSize = 4;
+    options.deadline = 100ms;
+    options.pollInterval = 1ms;
+    options.retries = 1;
+    return options;
+}
+
+WindowActionReport dispatchAndWait(WindowActionDispatcher &dispatcher,
+                                   std::vector<ProcessSnapshot::WindowHandle> windows, WindowAction action) {
+    std::promise<WindowActionReport> promise;
+    auto future = promise.get_future();
+    dispatcher.dispatch(std::move(windows), action, [&promise](WindowActionReport report) {
+        promise.set_value(std::move(report));
+    });
+    return future.get();
+}
+
+void waitUntilIssued(SimulatedWindowManager &wm, ProcessSnapshot::WindowHandle handle, int count) {
+    while (wm.issued(handle) < count) std::this_thread::sleep_for(1ms);
+}
+
+} // namespace
+
+class TestWindowActionDispatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testEmpty() {
+        SimulatedWindowManager wm;
+        WindowActionDispatcher dispatcher(wm, fastOptions());
+        auto report = dispatchAndWait(dispatcher, {}, WindowAction::Minimize);
+        QVERIFY(report.outcomes.empty());
+    }
+
+    void testResponsiveWindows() {
+        SimulatedWindowManager wm;
+        std::vector<ProcessSnapshot::WindowHandle> windows;
+        for (ProcessSnapshot::WindowHandle h = 1; h <= 10; ++h) {
+            wm.addWindow(h);
+            windows.push_back(h);
+        }
+        WindowActionDispatcher dispatcher(wm, fastOptions());
+        auto report = dispatchAndWait(dispatcher, windows, WindowAction::Minimize);
+
+        QCOMPARE(report.action, WindowAction::Minimize);
+        QCOMPARE(report.outcomes.size(), windows.size());
+        QCOMPARE(report.count(Result::Done), 10);
+        for (std::size_t i = 0; i < windows.size(); ++i) {
+            const auto &outcome = report.outcomes[i];
+            QCOMPARE(outcome.window, windows[i]); // Input order is kept
+            QCOMPARE(outcome.attempts, 1);
+            QCOMPARE(outcome.finalAction, WindowAction::Minimize);
+            QCOMPARE(wm.windowState(windows[i]), WindowState::Minimized);
+        }
+        QVERIFY(dispatcher.hiddenWindows().empty());
+    }
+
+    void testRestore() {
+        SimulatedWindowManager wm;
+        wm.addWindow(1, SimulatedWindowManager::Behavior::Responsive, 0ms, WindowState::Minimized);
+        wm.addWindow(2, SimulatedWindowManager::Behavior::Responsive, 0ms, WindowState::Hidden);
+        WindowActionDispatcher dispatcher(wm, fastOptions());
+        auto report = dispatchAndWait(dispatcher, { 1, 2 }, WindowAction::Restore);
+        QCOMPARE(report.count(Result::Done), 2);
+        QCOMPARE(wm.windowState(2), WindowState::Normal);
+    }
+
+    void testSlowWindowWithinDeadline() {
+        SimulatedWindowManager wm;
+        wm.addWindow(1, SimulatedWindowManager::Behavior::Responsive, 20ms);
+        WindowActionDispatcher dispatcher(wm, fastOptions());
+        auto report = dispatchAndWait(dispatcher, { 1 }, WindowAction::Minimize);
+        QCOMPARE(report.outcomes[0].result, Result::Done);
+        QCOMPARE(report.outcomes[0].attempts, 1);
+        QVERIFY(report.outcomes[0].elapsed >= 20ms);
+    }
+
+    void testRetry() {
+        SimulatedWindowManager wm;
+        wm.addWindow(1, SimulatedWindowManager::Behavior::IgnoresFirst);
+        WindowActionDispatcher dispatcher(wm, fastOptions());
+        auto report = dispatchAndWait(dispatcher, { 1 }, WindowAction::Minimize);
+        QCOMPARE(report.outcomes[0].result, Result::Done);
+        QCOMPARE(report.outcomes[0].attempts, 2);
+        QCOMPARE(wm.log(1), std::vector<WindowAction>({ WindowAction::Minimize, WindowAction::Minimize }));
+    }
+
+    void testRefusingWindowIsHidden() {
+        SimulatedWindowManager wm;
+        wm.addWindow(1, SimulatedWindowManager::Behavior::RefusesMinimize);
+        WindowActionDispatcher dispatcher(wm, fastOptions());
+        auto report = dispatchAndWait(dispatcher, { 1 }, WindowAction::Minimize);
+
+        const auto &outcome = report.outcomes[0];
+        QCOMPARE(outcome.result, Result::Escalated);
+        QCOMPARE(outcome.finalAction, WindowAction::Hide);
+        QCOMPARE(outcome.attempts, 3); // Minimize, retry, hide
+        QCOMPARE(wm.windowState(1), WindowState::Hidden);
+        QCOMPARE(dispatcher.hiddenWindows(), std::vector<ProcessSnapshot::WindowHandle>({ 1 }));
+    }
+
+    void testNoEscalation() {
+        SimulatedWindowManager wm;
+        wm.addWindow(1, SimulatedWindowManager::Behavior::RefusesMinimize);
+        WindowDispatchOptions options = fastOptions();
+        options.escalateToHide = false;
+        WindowActionDispatcher dispatcher(wm, options);
+        auto report = dispatchAndWait(dispatcher, { 1 }, WindowAction::Minimize);
+        QCOMPARE(report.outcomes[0].result, Result::TimedOut);
+        QCOMPARE(report.outcomes[0].attempts, 2);
+        QCOMPARE(wm.windowState(1), WindowState::Normal);
+        QVERIFY(dispatcher.hiddenWindows().empty());
+    }
+
+    void testHungWindowIsNotHidden() {
+        SimulatedWindowManager wm;
+        wm.addWindow(1, SimulatedWindowManager::Behavior::Hung);
+        WindowActionDispatcher dispatcher(wm, fastOptions());
+        auto report = dispatchAndWait(dispatcher, { 1 }, WindowAction::Minimize);
+
+        // A hide would just queue up behind the ignored minimize and fire
+        // whenever the window recovers
+        const auto &outcome = report.outcomes[0];
+        QCOMPARE(outcome.result, Result::TimedOut);
+        QCOMPARE(outcome.finalAction, WindowAction::Minimize);
+        QCOMPARE(outcome.attempts, 2);
+        QCOMPARE(wm.log(1), std::vector<WindowAction>({ WindowAction::Minimize, WindowAction::Minimize }));
+        QVERIFY(outcome.elapsed >= 2 * fastOptions().deadline);
+        QVERIFY(dispatcher.hiddenWindows().empty());
+    }
+
+    void testTimedOutHideIsTracked() {
+        SimulatedWindowManager wm;
+        wm.addWindow(1, SimulatedWindowManager::Behavior::IgnoresEverything);
+        WindowActionDispatcher dispatcher(wm, fastOptions());
+        auto report = dispatchAndWait(dispatcher, { 1 }, WindowAction::Minimize);
+
+        // The hides are still queued, so the window may vanish later
+        QCOMPARE(report.outcomes[0].result, Result::TimedOut);
+        QCOMPARE(report.outcomes[0].finalAction, WindowAction::Hide);
+        QCOMPARE(report.outcomes[0].attempts, 4); // Two minimizes, two hides
+        QCOMPARE(dispatcher.hiddenWindows(), std::vector<ProcessSnapshot::WindowHandle>({ 1 }));
+    }
+
+    void testRestoreForgetsHiddenWindows() {
+        SimulatedWindowManager wm;
+        wm.addWindow(1, SimulatedWindowManager::Behavior::RefusesMinimize);
+        WindowActionDispatcher dispatcher(wm, fastOptions());
+        QCOMPARE(dispatchAndWait(dispatcher, { 1 }, WindowAction::Minimize).outcomes[0].result, Result::Escalated);
+
+        auto report = dispatchAndWait(dispatcher, dispatcher.hiddenWindows(), WindowAction::Restore);
+        QCOMPARE(report.count(Result::Done), 1);
+        QCOMPARE(wm.windowState(1), WindowState::Normal);
+        QVERIFY(dispatcher.hiddenWindows().empty());
+    }
+
+    void testFailedRestoreKeepsHiddenWindows() {
+        SimulatedWindowManager wm;
+        wm.addWindow(1, SimulatedWindowManager::Behavior::RefusesMinimize);
+        WindowActionDispatcher dispatcher(wm, fastOptions());
+        dispatchAndWait(dispatcher, { 1 }, WindowAction::Minimize);
+
+        wm.setBehavior(1, SimulatedWindowManager::Behavior::Hung);
+        auto report = dispatchAndWait(dispatcher, { 1 }, WindowAction::Restore);
+        QCOMPARE(report.outcomes[0].result, Result::TimedOut);
+        QCOMPARE(wm.windowState(1), WindowState::Hidden);
+        QCOMPARE(dispatcher.hiddenWindows(), std::vector<ProcessSnapshot::WindowHandle>({ 1 }));
+    }
+
+    void testReleaseHiddenWindows() {
+        SimulatedWindowManager wm;
+        wm.addWindow(1, SimulatedWindowManager::Behavior::RefusesMinimize);
+        wm.addWindow(2);
+        WindowActionDispatcher dispatcher(wm, fastOptions());
+        dispatchAndWait(dispatcher, { 1, 2 }, WindowAction::Minimize);
+        QCOMPARE(wm.windowState(1), WindowState::Hidden);
+
+        dispatcher.releaseHiddenWindows();
+        QVERIFY(dispatcher.hiddenWindows().empty());
+        QCOMPARE(wm.windowState(1), WindowState::Normal);
+        QCOMPARE(wm.windowState(2), WindowState::Minimized); // Only what we hid
+    }
+
+    void testReleaseStopsRunningJobs() {
+        SimulatedWindowManager wm;
+        wm.addWindow(1, SimulatedWindowManager::Behavior::RefusesMinimize);
+        WindowActionDispatcher dispatcher(wm, fastOptions());
+
+        std::promise<WindowActionReport> promise;
+        dispatcher.dispatch({ 1 }, WindowAction::Minimize,
+                            [&promise](WindowActionReport report) { promise.set_value(std::move(report)); });
+        waitUntilIssued(wm, 1, 1);
+        dispatcher.releaseHiddenWindows();
+
+        QCOMPARE(promise.get_future().get().outcomes[0].result, Result::Superseded);
+        QCOMPARE(wm.log(1), std::vector<WindowAction>({ WindowAction::Minimize }));
+        QCOMPARE(wm.windowState(1), WindowState::Normal);
+    }
+
+    void testNewerDispatchSupersedes() {
+        SimulatedWindowManager wm;
+        wm.addWindow(1, SimulatedWindowManager::Behavior::RefusesMinimize);
+        wm.addWindow(2, SimulatedWindowManager::Behavior::Hung);
+        WindowActionDispatcher dispatcher(wm, fastOptions());
+
+        std::promise<WindowActionReport> minimized;
+        dispatcher.dispatch({ 1, 2 }, WindowAction::Minimize,
+                            [&minimized](WindowActionReport report) { minimized.set_value(std::move(report)); });
+        waitUntilIssued(wm, 1, 1);
+        waitUntilIssued(wm, 2, 1);
+
+        // Restore while the minimize job is still waiting to retry
+        auto restored = dispatchAndWait(dispatcher, { 1 }, WindowAction::Restore);
+        QCOMPARE(restored.outcomes[0].result, Result::Done);
+
+        auto report = minimized.get_future().get();
+        QCOMPARE(report.outcomes[0].result, Result::Superseded);
+        QCOMPARE(report.outcomes[0].finalAction, WindowAction::Minimize);
+        QCOMPARE(report.outcomes[1].result, Result::TimedOut); // Not part of the restore
+
+        // Nothing from the minimize job may land after the restore
+        const auto log = wm.log(1);
+        const auto restore = std::find(log.begin(), log.end(), WindowAction::Restore);
+        QVERIFY(restore != log.end());
+        QCOMPARE(std::count(restore, log.end(), WindowAction::Restore), std::ptrdiff_t(log.end() - restore));
+        QCOMPARE(wm.windowState(1), WindowState::Normal);
+        QVERIFY(dispatcher.hiddenWindows().empty());
+    }
+
+    void testHungWindowsDontDelayOthers() {
+        SimulatedWindowManager wm;
+        std::vector<ProcessSnapshot::WindowHandle> windows;
+        for (ProcessSnapshot::WindowHandle h = 1; h <= 16; ++h) {
+            // Every batch gets a hung window
+            wm.addWindow(h, h % 4 == 0 ? SimulatedWindowManager::Behavior::Hung
+                                       : SimulatedWindowManager::Behavior::Responsive);
+            windows.push_back(h);
+        }
+        WindowActionDispatcher dispatcher(wm, fastOptions());
+        auto report = dispatchAndWait(dispatcher, windows, WindowAction::Minimize);
+
+        QCOMPARE(report.count(Result::Done), 12);
+        QCOMPARE(report.count(Result::TimedOut), 4);
+
+        // Responsive windows settle on the first attempt, before any hung
+        // window in the same batch has even been retried
+        std::chrono::microseconds firstTimeout = std::chrono::microseconds::max();
+        for (const auto &outcome : report.outcomes) {
+            if (outcome.result == Result::TimedOut) firstTimeout = std::min(firstTimeout, outcome.elapsed);
+        }
+        for (const auto &outcome : report.outcomes) {
+            if (outcome.result != Result::Done) continue;
+            QCOMPARE(outcome.attempts, 1);
+            QVERIFY(outcome.elapsed < firstTimeout);
+        }
+    }
+
+    void testBatchesRunInParallel() {
+        SimulatedWindowManager wm;
+        std::vector<ProcessSnapshot::WindowHandle> windows;
+        for (ProcessSnapshot::WindowHandle h = 1; h <= 16; ++h) {
+            wm.addWindow(h, SimulatedWindowManager::Behavior::Hung);
+            windows.push_back(h);
+        }
+        WindowDispatchOptions options = fastOptions();
+        options.retries = 0;
+        WindowActionDispatcher dispatcher(wm, options);
+        auto report = dispatchAndWait(dispatcher, windows, WindowAction::Minimize);
+
+        // 4 batches of one deadline each on 4 workers. One after another
+        // would take 4 deadlines; allow 3 so a slow machine has slack.
+        QCOMPARE(report.count(Result::TimedOut), 16);
+        QVERIFY(report.elapsed >= options.deadline);
+        QVERIFY(report.elapsed < 3 * options.deadline);
+    }
+
+    void testClosedWindow() {
+        SimulatedWindowManager wm;
+        wm.addWindow(1, SimulatedWindowManager::Behavior::Hung);
+        wm.addWindow(2);
+        WindowActionDispatcher dispatcher(wm, fastOptions());
+
+        std::promise<WindowActionReport> promise;
+        auto future = promise.get_future();
+        dispatcher.dispatch({ 1, 2, 3 }, WindowAction::Minimize, [&promise](WindowActionReport report) {
+            promise.set_value(std::move(report));
+        });
+        waitUntilIssued(wm, 1, 1);
+        wm.closeWindow(1);
+        auto report = future.get();
+
+        QCOMPARE(report.outcomes[0].result, Result::Gone);
+        QCOMPARE(report.outcomes[1].result, Result::Done);
+        QCOMPARE(report.outcomes[2].result, Result::Gone); // Never existed
+    }
+
+    void testConcurrentDispatches() {
+        SimulatedWindowManager wm;
+        for (ProcessSnapshot::WindowHandle h = 1; h <= 8; ++h) {
+            wm.addWindow(h, SimulatedWindowManager::Behavior::Responsive, 5ms);
+        }
+        WindowActionDispatcher dispatcher(wm, fastOptions());
+
+        std::promise<WindowActionReport> first, second;
+        dispatcher.dispatch({ 1, 2, 3, 4 }, WindowAction::Minimize,
+                            [&first](WindowActionReport report) { first.set_value(std::move(report)); });
+        dispatcher.dispatch({ 5, 6, 7, 8 }, WindowAction::Hide,
+                            [&second](WindowActionReport report) { second.set_value(std::move(report)); });
+
+        QCOMPARE(first.get_future().get().count(Result::Done), 4);
+        QCOMPARE(second.get_future().get().count(Result::Done), 4);
+        QCOMPARE(wm.windowState(8), WindowState::Hidden);
+    }
+};
+
+QTEST_APPLESS_MAIN(TestWindowActionDispatcher)
+#include "tst_windowactiondispatcher.moc"
@@ -1,6 +1,21 @@
 #include "utils.h"
 
-DWORD qtKeyToWinVK(int key) {
+// Values from <winuser.h>, spelled out so this file builds without windows.h
+namespace {
+constexpr std::uint32_t VK_BACK   = 0x08;
+constexpr std::uint32_t VK_TAB    = 0x09;
+constexpr std::uint32_t VK_ESCAPE = 0x1B;
+constexpr std::uint32_t VK_SPACE  = 0x20;
+constexpr std::uint32_t VK_DELETE = 0x2E;
+constexpr std::uint32_t VK_F1     = 0x70;
+
+constexpr std::uint32_t MOD_ALT     = 0x1;
+constexpr std::uint32_t MOD_CONTROL = 0x2;
+constexpr std::uint32_t MOD_SHIFT   = 0x4;
+constexpr std::uint32_t MOD_WIN     = 0x8;
+}
+
+std::uint32_t qtKeyToWinVK(int key) {
     // Strip modifiers
     key &= ~Qt::KeyboardModifierMask;
 
@@ -9,20 +24,13 @@ DWORD qtKeyToWinVK(int key) {
         return key;
     }
 
-    // 2. Handle Special Keys
+    // 2. F1-F12 are contiguous in both
+    if (key >= Qt::Key_F1 && key <= Qt::Key_F12) {
+        return VK_F1 + (key - Qt::Key_F1);
+    }
+
+    // 3. Handle Special Keys
     switch (key) {
-    case Qt::Key_F1: return VK_F1;
-    case Qt::Key_F2: return VK_F2;
-    case Qt::Key_F3: return VK_F3;
-    case Qt::Key_F4: return VK_F4;
-    case Qt::Key_F5: return VK_F5;
-    case Qt::Key_F6: return VK_F6;
-    case Qt::Key_F7: return VK_F7;
-    case Qt::Key_F8: return VK_F8;
-    case Qt::Key_F9: return VK_F9;
-    case Qt::Key_F10: return VK_F10;
-    case Qt::Key_F11: return VK_F11;
-    case Qt::Key_F12: return VK_F12;
     case Qt::Key_Escape: return VK_ESCAPE;
     case Qt::Key_Delete: return VK_DELETE;
     case Qt::Key_Space:  return VK_SPACE;
@@ -32,3 +40,12 @@ DWORD qtKeyToWinVK(int key) {
 
     return 0;
 }
+
+std::uint32_t qtModifiersToWinMod(Qt::KeyboardModifiers modifiers) {
+    std::uint32_t mod = 0;
+    if (modifiers & Qt::ControlModifier) mod |= MOD_CONTROL;
+    if (modifiers & Qt::AltModifier)     mod |= MOD_ALT;
+    if (modifiers & Qt::ShiftModifier)   mod |= MOD_SHIFT;
+    if (modifiers & Qt::MetaModifier)    mod |= MOD_WIN;
+    return mod;
+}
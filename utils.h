@@ -2,8 +2,12 @@
 #define UTILS_H
 
 #include <Qt>
-#include <windows.h>
+#include <cstdint>
 
-DWORD qtKeyToWinVK(int key);
+// Win32 virtual-key code (VK_*) for a Qt key, 0 if unmapped
+std::uint32_t qtKeyToWinVK(int key);
+
+// Win32 RegisterHotKey modifier mask (MOD_*) for Qt modifiers
+std::uint32_t qtModifiersToWinMod(Qt::KeyboardModifiers modifiers);
 
 #endif // UTILS_H
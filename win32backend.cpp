@@ -0,0 +1,179 @@
+#include "win32backend.h"
+#include "win32utils.h"
+#include "utils.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <algorithm>
+#include <string>
+#include <tlhelp32.h>
+
+Win32Backend::Win32Backend() {
+    // Create and install native hotkey filter
+    qApp->installNativeEventFilter(&hotkeyFilter);
+
+    keyboardHook.matcher().setChordTimeout(1500);
+
+    hotkeyFilter.onHotkeyPressed = [this](int id) {
+        if (onHotkeyPressed) onHotkeyPressed(id);
+    };
+}
+
+Win32Backend::~Win32Backend() {
+    unregisterHotkeys();
+    qApp->removeNativeEventFilter(&hotkeyFilter);
+}
+
+namespace {
+
+// Calls visit(pid, window) for visible top-level windows only (no tooltips/popups)
+template <typename Visit>
+void forEachTopLevelWindow(Visit visit) {
+    EnumWindows([](HWND hwnd, LPARAM lParam) -> BOOL {
+        if (!IsWindowVisible(hwnd) || GetWindow(hwnd, GW_OWNER) != nullptr) return TRUE;
+
+        DWORD pid = 0;
+        GetWindowThreadProcessId(hwnd, &pid);
+        (*reinterpret_cast<Visit*>(lParam))(pid, reinterpret_cast<ProcessSnapshot::WindowHandle>(hwnd));
+        return TRUE;
+    }, reinterpret_cast<LPARAM>(&visit));
+}
+
+} // namespace
+
+std::unique_ptr<ProcessSnapshot> Win32Backend::captureProcesses() {
+    ProcessSnapshotBuilder builder;
+
+    ScopedHandle snapshot(CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0));
+    if (snapshot.get() != INVALID_HANDLE_VALUE) {
+        PROCESSENTRY32W pe;
+        pe.dwSize = sizeof(PROCESSENTRY32W);
+
+        if (Process32FirstW(snapshot.get(), &pe)) {
+            do {
+                // wchar_t is UTF-16 on Windows
+                builder.addProcess(pe.th32ProcessID, pe.th32ParentProcessID,
+                                   reinterpret_cast<const char16_t*>(pe.szExeFile));
+            } while (Process32NextW(snapshot.get(), &pe));
+        }
+    }
+
+    forEachTopLevelWindow([&builder](DWORD pid, ProcessSnapshot::WindowHandle window) {
+        builder.addWindow(pid, window);
+    });
+
+    return builder.build();
+}
+
+std::vector<ProcessSnapshot::WindowHandle> Win32Backend::captureWindows(std::vector<ProcessSnapshot::Pid> pids) {
+    std::vector<ProcessSnapshot::WindowHandle> windows;
+    // Nothing to find windows for
+    if (pids.empty()) return windows;
+
+    std::sort(pids.begin(), pids.end());
+    forEachTopLevelWindow([&](DWORD pid, ProcessSnapshot::WindowHandle window) {
+        if (std::binary_search(pids.begin(), pids.end(), ProcessSnapshot::Pid(pid))) windows.push_back(window);
+    });
+    return windows;
+}
+
+QString Win32Backend::processImagePath(ProcessSnapshot::Pid pid) {
+    ScopedHandle process(OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid));
+    if (!process) return QString();
+
+    WCHAR path[MAX_PATH] = {0};
+    DWORD size = MAX_PATH;
+    if (!QueryFullProcessImageNameW(process.get(), 0, path, &size)) return QString();
+    return QString::fromWCharArray(path, qsizetype(size));
+}
+
+void Win32Backend::applyWindowAction(ProcessSnapshot::WindowHandle window, WindowAction action) {
+    int command = SW_RESTORE;
+    switch (action) {
+    case WindowAction::Minimize: command = SW_MINIMIZE; break;
+    case WindowAction::Restore:  command = SW_RESTORE; break;
+    case WindowAction::Hide:     command = SW_HIDE; break;
+    }
+    // Posts to the window's thread, so a hung window can't stall us
+    ShowWindowAsync(reinterpret_cast<HWND>(window), command);
+}
+
+WindowState Win32Backend::windowState(ProcessSnapshot::WindowHandle window) {
+    // These read the window's state without sending it a message, so
+    // they're safe on hung windows
+    HWND hwnd = reinterpret_cast<HWND>(window);
+    if (!IsWindow(hwnd)) return WindowState::Gone;
+    if (!IsWindowVisible(hwnd)) return WindowState::Hidden;
+    if (IsIconic(hwnd)) return WindowState::Minimized;
+    return WindowState::Normal;
+}
+
+bool Win32Backend::isResponding(ProcessSnapshot::WindowHandle window) {
+    // Same test the shell uses for "(Not Responding)"; doesn't message the window
+    return !IsHungAppWindow(reinterpret_cast<HWND>(window));
+}
+
+bool Win32Backend::registerHotkey(const HotkeyBinding &binding) {
+    // Multi-chord sequences ("Ctrl+K, Ctrl+M") can only be matched by the hook
+    if (!binding.isMultiChord()) {
+        UINT mod = 0, vk = 0;
+        if (!binding.isEmpty()) {
+            mod = qtModifiersToWinMod(binding.chords[0].keyboardModifiers());
+            vk = qtKeyToWinVK(binding.chords[0].key());
+        }
+        if (!RegisterHotKey(nullptr, binding.id, mod, vk)) return false;
+        registeredIds.push_back(binding.id);
+        return true;
+    }
+
+    std::vector<ChordMatcher::Chord> chords;
+    for (QKeyCombination combination : binding.chords) {
+        std::uint32_t vk = qtKeyToWinVK(combination.key());
+        if (!vk) return false;
+        chords.push_back(ChordMatcher::makeChord(std::uint16_t(qtModifiersToWinMod(combination.keyboardModifiers())),
+                                                 std::uint16_t(vk)));
+    }
+
+    // The hook thread reads the matcher, so stop it while editing
+    keyboardHook.uninstall();
+    const bool added = keyboardHook.matcher().addSequence(chords, binding.id);
+    const bool installed = !keyboardHook.matcher().isEmpty() && keyboardHook.install();
+    if (!installed) keyboardHook.matcher().clear();
+    return added && installed;
+}
+
+void Win32Backend::unregisterHotkeys() {
+    for (int id : registeredIds) UnregisterHotKey(nullptr, id);
+    registeredIds.clear();
+    keyboardHook.uninstall();
+    keyboardHook.matcher().clear();
+}
+
+bool Win32Backend::setLaunchAtStartup(bool enabled) {
+    HKEY rawKey = nullptr;
+    LONG result = RegOpenKeyExW(HKEY_CURRENT_USER,
+                                L"Software\\Microsoft\\Windows\\CurrentVersion\\Run",
+                                0, KEY_WRITE, &rawKey);
+
+    if (result != ERROR_SUCCESS) return false;
+
+    // RAII: Key automatically closes when this scope ends (even if RegSetValueExW throws/fails)
+    ScopedRegistryKey hKey(rawKey);
+
+    if (!enabled) {
+        result = RegDeleteValueW(hKey.get(), L"MinimizerApp");
+        qDebug("Removed from startup");
+        return (result == ERROR_SUCCESS);
+    }
+
+    wchar_t exePath[MAX_PATH];
+    if (GetModuleFileNameW(NULL, exePath, MAX_PATH) == 0) return false;
+
+    std::wstring value = std::wstring(L"\"") + exePath + L"\" --minimized";
+
+    result = RegSetValueExW(hKey.get(), L"MinimizerApp", 0, REG_SZ,
+                            reinterpret_cast<const BYTE*>(value.c_str()),
+                            (value.size() + 1) * sizeof(wchar_t));
+
+    qDebug("Added to startup.");
+    return (result == ERROR_SUCCESS);
+}
@@ -0,0 +1,35 @@
+#ifndef WIN32BACKEND_H
+#define WIN32BACKEND_H
+
+#include <vector>
+#include "platformbackend.h"
+#include "hotkeyeventfilter.h"
+#include "keyboardhook.h"
+
+// Single-chord hotkeys use RegisterHotKey, multi-chord ones the low-level
+// keyboard hook. Both arrive as WM_HOTKEY through a native event filter,
+// so create this on the GUI thread after QCoreApplication.
+class Win32Backend : public PlatformBackend {
+public:
+    Win32Backend();
+    ~Win32Backend() override;
+
+    std::unique_ptr<ProcessSnapshot> captureProcesses() override;
+    std::vector<ProcessSnapshot::WindowHandle> captureWindows(std::vector<ProcessSnapshot::Pid> pids) override;
+    QString processImagePath(ProcessSnapshot::Pid pid) override;
+    void applyWindowAction(ProcessSnapshot::WindowHandle window, WindowAction action) override;
+    WindowState windowState(ProcessSnapshot::WindowHandle window) override;
+    bool isResponding(ProcessSnapshot::WindowHandle window) override;
+
+    bool registerHotkey(const HotkeyBinding &binding) override;
+    void unregisterHotkeys() override;
+
+    bool setLaunchAtStartup(bool enabled) override;
+
+private:
+    HotkeyEventFilter hotkeyFilter;
+    KeyboardHook keyboardHook;
+    std::vector<int> registeredIds;
+};
+
+#endif // WIN32BACKEND_H
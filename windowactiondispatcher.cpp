@@ -0,0 +1,237 @@
+#include "windowactiondispatcher.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+bool isSettled(WindowAction action, WindowState state) {
+    switch (action) {
+    case WindowAction::Minimize:
+        // An app that hides itself to the tray is out of the way too
+        return state == WindowState::Minimized || state == WindowState::Hidden;
+    case WindowAction::Restore:
+        return state == WindowState::Normal;
+    case WindowAction::Hide:
+        return state == WindowState::Hidden;
+    }
+    return false;
+}
+
+} // namespace
+
+int WindowActionReport::count(WindowActionOutcome::Result result) const {
+    return int(std::count_if(outcomes.begin(), outcomes.end(),
+                             [result](const WindowActionOutcome &o) { return o.result == result; }));
+}
+
+struct WindowActionDispatcher::Job {
+    std::uint64_t generation = 0;
+    std::vector<ProcessSnapshot::WindowHandle> windows;
+    Callback onFinished;
+    Clock::time_point start;
+    WindowActionReport report;
+    std::atomic<std::size_t> remainingBatches{0};
+};
+
+WindowActionDispatcher::WindowActionDispatcher(WindowManager &manager)
+    : WindowActionDispatcher(manager, WindowDispatchOptions())
+{
+}
+
+WindowActionDispatcher::WindowActionDispatcher(WindowManager &manager, const WindowDispatchOptions &options)
+    : m_manager(manager)
+    , m_options(options)
+{
+    m_options.workers = std::max(1, m_options.workers);
+    m_options.batchSize = std::max<std::size_t>(1, m_options.batchSize);
+
+    for (int i = 0; i < m_options.workers; ++i) {
+        m_workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+WindowActionDispatcher::~WindowActionDispatcher() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    // Queued batches still run, so every callback fires exactly once
+    for (std::thread &worker : m_workers) worker.join();
+}
+
+void WindowActionDispatcher::workerLoop() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+            if (m_queue.empty()) return;
+            task = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+        task();
+    }
+}
+
+void WindowActionDispatcher::dispatch(std::vector<ProcessSnapshot::WindowHandle> windows, WindowAction action, Callback onFinished) {
+    auto job = std::make_shared<Job>();
+    job->start = Clock::now();
+    job->onFinished = std::move(onFinished);
+    job->report.action = action;
+    job->report.outcomes.resize(windows.size());
+    for (std::size_t i = 0; i < windows.size(); ++i) {
+        job->report.outcomes[i].window = windows[i];
+        job->report.outcomes[i].finalAction = action;
+    }
+    job->windows = std::move(windows);
+
+    {
+        std::lock_guard<std::mutex> lock(m_windowsMutex);
+        job->generation = ++m_nextGeneration;
+        for (ProcessSnapshot::WindowHandle window : job->windows) m_latest[window] = job->generation;
+    }
+
+    if (job->windows.empty()) {
+        if (job->onFinished) job->onFinished(std::move(job->report));
+        return;
+    }
+
+    const std::size_t batchSize = m_options.batchSize;
+    const std::size_t batches = (job->windows.size() + batchSize - 1) / batchSize;
+    job->remainingBatches = batches;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (std::size_t b = 0; b < batches; ++b) {
+            const std::size_t begin = b * batchSize;
+            const std::size_t end = std::min(begin + batchSize, job->windows.size());
+            m_queue.emplace_back([this, job, begin, end] { runBatch(*job, begin, end); });
+        }
+    }
+    m_wake.notify_all();
+}
+
+std::vector<ProcessSnapshot::WindowHandle> WindowActionDispatcher::hiddenWindows() const {
+    std::lock_guard<std::mutex> lock(m_windowsMutex);
+    return std::vector<ProcessSnapshot::WindowHandle>(m_hidden.begin(), m_hidden.end());
+}
+
+void WindowActionDispatcher::releaseHiddenWindows() {
+    std::lock_guard<std::mutex> lock(m_windowsMutex);
+    // A new generation nobody owns: running jobs see every window superseded
+    ++m_nextGeneration;
+    for (auto &entry : m_latest) entry.second = m_nextGeneration;
+    for (ProcessSnapshot::WindowHandle window : m_hidden) {
+        m_manager.applyWindowAction(window, WindowAction::Restore);
+    }
+    m_hidden.clear();
+}
+
+bool WindowActionDispatcher::isLatestLocked(const Job &job, ProcessSnapshot::WindowHandle window) const {
+    auto it = m_latest.find(window);
+    return it != m_latest.end() && it->second == job.generation;
+}
+
+bool WindowActionDispatcher::issue(const Job &job, ProcessSnapshot::WindowHandle window, WindowAction action) {
+    // Checked and issued under one lock, so a newer dispatch's actions always
+    // come after ours. applyWindowAction never blocks, so holding it is cheap.
+    std::lock_guard<std::mutex> lock(m_windowsMutex);
+    if (!isLatestLocked(job, window)) return false;
+    m_manager.applyWindowAction(window, action);
+    if (action == WindowAction::Hide) m_hidden.insert(window);
+    return true;
+}
+
+void WindowActionDispatcher::runBatch(Job &job, std::size_t begin, std::size_t end) {
+    struct Pending {
+        std::size_t index;
+        WindowAction action;
+        int tries; // Of the current action
+    };
+
+    std::vector<Pending> pending;
+    pending.reserve(end - begin);
+    for (std::size_t i = begin; i < end; ++i) pending.push_back({ i, job.report.action, 0 });
+
+    auto settle = [&](const Pending &p, WindowActionOutcome::Result result) {
+        WindowActionOutcome &outcome = job.report.outcomes[p.index];
+        outcome.result = result;
+        outcome.finalAction = p.action;
+        outcome.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - job.start);
+    };
+
+    while (!pending.empty()) {
+        // Issue to the whole batch first, so slow windows work in parallel
+        pending.erase(std::remove_if(pending.begin(), pending.end(), [&](Pending &p) {
+            if (!issue(job, job.windows[p.index], p.action)) {
+                settle(p, WindowActionOutcome::Result::Superseded);
+                return true;
+            }
+            ++p.tries;
+            ++job.report.outcomes[p.index].attempts;
+            return false;
+        }), pending.end());
+        if (pending.empty()) break;
+
+        const Clock::time_point deadline = Clock::now() + m_options.deadline;
+        for (;;) {
+            pending.erase(std::remove_if(pending.begin(), pending.end(), [&](const Pending &p) {
+                const ProcessSnapshot::WindowHandle window = job.windows[p.index];
+                const WindowState state = m_manager.windowState(window);
+
+                std::lock_guard<std::mutex> lock(m_windowsMutex);
+                if (!isLatestLocked(job, window)) {
+                    settle(p, WindowActionOutcome::Result::Superseded);
+                    return true;
+                }
+                if (state == WindowState::Gone) {
+                    m_hidden.erase(window);
+                    settle(p, WindowActionOutcome::Result::Gone);
+                    return true;
+                }
+                if (isSettled(p.action, state)) {
+                    if (job.report.action == WindowAction::Restore) m_hidden.erase(window);
+                    settle(p, p.action == job.report.action ? WindowActionOutcome::Result::Done
+                                                            : WindowActionOutcome::Result::Escalated);
+                    return true;
+                }
+                return false;
+            }), pending.end());
+
+            if (pending.empty() || Clock::now() >= deadline) break;
+            std::this_thread::sleep_for(m_options.pollInterval);
+        }
+
+        // Missed the deadline: retry, then escalate, then give up. A hung
+        // window would only queue the hide behind the minimize it ignored.
+        for (auto it = pending.begin(); it != pending.end();) {
+            if (it->tries <= m_options.retries) {
+                ++it;
+            } else if (it->action == WindowAction::Minimize && m_options.escalateToHide
+                       && m_manager.isResponding(job.windows[it->index])) {
+                it->action = WindowAction::Hide;
+                it->tries = 0;
+                ++it;
+            } else {
+                settle(*it, WindowActionOutcome::Result::TimedOut);
+                it = pending.erase(it);
+            }
+        }
+    }
+
+    // The last batch to finish hands the whole report over
+    if (job.remainingBatches.fetch_sub(1) == 1) {
+        {
+            // Windows nobody has dispatched to since are ours to forget
+            std::lock_guard<std::mutex> lock(m_windowsMutex);
+            for (ProcessSnapshot::WindowHandle window : job.windows) {
+                if (isLatestLocked(job, window)) m_latest.erase(window);
+            }
+        }
+        job.report.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - job.start);
+        if (job.onFinished) job.onFinished(std::move(job.report));
+    }
+}
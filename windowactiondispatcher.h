@@ -0,0 +1,107 @@
+#ifndef WINDOWACTIONDISPATCHER_H
+#define WINDOWACTIONDISPATCHER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "windowmanager.h"
+
+struct WindowActionOutcome {
+    enum class Result {
+        Done,       // Reached the requested state
+        Escalated,  // Ignored the request, but was hidden instead
+        TimedOut,   // Never responded, even to escalation (hung windows aren't escalated)
+        Gone,       // Closed before it could be verified
+        Superseded, // A later dispatch took the window over; nothing more was issued
+    };
+
+    ProcessSnapshot::WindowHandle window = 0;
+    Result result = Result::TimedOut;
+    WindowAction finalAction = WindowAction::Minimize; // Last action issued
+    int attempts = 0;                                  // Actions issued, escalation included
+    std::chrono::microseconds elapsed{0};              // From dispatch until settled
+};
+
+struct WindowActionReport {
+    WindowAction action = WindowAction::Minimize;
+    std::vector<WindowActionOutcome> outcomes; // Same order as the requested windows
+    std::chrono::microseconds elapsed{0};
+
+    int count(WindowActionOutcome::Result result) const;
+};
+
+struct WindowDispatchOptions {
+    int workers = 4;
+    std::size_t batchSize = 8;
+    std::chrono::milliseconds deadline{200};     // Per attempt
+    std::chrono::milliseconds pollInterval{5};
+    int retries = 1;                             // Re-issues of the same action
+    bool escalateToHide = true;                  // Hide responsive windows that won't minimize
+};
+
+// Applies an action to many windows on a small worker pool and verifies each
+// one actually changed state. Windows are split into batches; a worker issues
+// the action to its whole batch, then polls until every window has settled or
+// the deadline passes, retrying and escalating the stragglers. A hung window
+// only ever costs its own deadline, never the other windows'.
+//
+// Every dispatch takes its windows over: an older job still working on one
+// of them stops issuing to it and reports it as Superseded, so a restore
+// can't be undone by a minimize retry that was already queued. Windows sent
+// a Hide are remembered until a restore reaches them or they close, since
+// snapshots don't list hidden windows.
+class WindowActionDispatcher {
+public:
+    using Callback = std::function<void(WindowActionReport)>;
+
+    explicit WindowActionDispatcher(WindowManager &manager);
+    WindowActionDispatcher(WindowManager &manager, const WindowDispatchOptions &options);
+    ~WindowActionDispatcher();
+
+    WindowActionDispatcher(const WindowActionDispatcher&) = delete;
+    WindowActionDispatcher& operator=(const WindowActionDispatcher&) = delete;
+
+    // Returns immediately. onFinished runs on a worker thread once every
+    // window has an outcome (or right away if there are no windows).
+    void dispatch(std::vector<ProcessSnapshot::WindowHandle> windows, WindowAction action, Callback onFinished);
+
+    // Windows this dispatcher hid that haven't been restored since
+    std::vector<ProcessSnapshot::WindowHandle> hiddenWindows() const;
+
+    // Supersedes every running job and sends Restore, without waiting, to
+    // all hidden windows. For shutdown: nothing may stay hidden after we exit.
+    void releaseHiddenWindows();
+
+private:
+    struct Job;
+
+    void workerLoop();
+    void runBatch(Job &job, std::size_t begin, std::size_t end);
+    // Issues unless a newer dispatch owns the window; false if it does
+    bool issue(const Job &job, ProcessSnapshot::WindowHandle window, WindowAction action);
+    bool isLatestLocked(const Job &job, ProcessSnapshot::WindowHandle window) const;
+
+    WindowManager &m_manager;
+    WindowDispatchOptions m_options;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::deque<std::function<void()>> m_queue;
+    bool m_stopping = false;
+    std::vector<std::thread> m_workers;
+
+    // Window ownership and hide tracking, shared by all jobs
+    mutable std::mutex m_windowsMutex;
+    std::uint64_t m_nextGeneration = 0;
+    std::unordered_map<ProcessSnapshot::WindowHandle, std::uint64_t> m_latest; // Generation of the owning job
+    std::unordered_set<ProcessSnapshot::WindowHandle> m_hidden;
+};
+
+#endif // WINDOWACTIONDISPATCHER_H
@@ -0,0 +1,51 @@
+#include "windowactions.h"
+#include <QDebug>
+#include <algorithm>
+#include "processmatcher.h"
+
+void dispatchToProcessWindows(const ProcessSnapshotPublisher &snapshots, PlatformBackend &backend,
+                              WindowActionDispatcher &dispatcher,
+                              const QStringList &processNames, WindowAction action,
+                              WindowActionDispatcher::Callback onFinished) {
+    std::vector<ProcessSnapshot::Pid> pids;
+    {
+        // Hold the guard only for the name matching
+        auto snapshot = snapshots.read();
+        pids = ProcessMatcher(processNames).pids(*snapshot);
+    }
+    // Windows come and go faster than processes, so don't trust the snapshot's
+    auto windows = backend.captureWindows(std::move(pids));
+
+    // The dispatcher forgets hidden windows only once a restore reaches them
+    if (action == WindowAction::Restore) {
+        for (ProcessSnapshot::WindowHandle window : dispatcher.hiddenWindows()) {
+            if (std::find(windows.begin(), windows.end(), window) == windows.end()) windows.push_back(window);
+        }
+    }
+
+    dispatcher.dispatch(std::move(windows), action, std::move(onFinished));
+}
+
+void traceWindowActionReport(const WindowActionReport &report) {
+    using Result = WindowActionOutcome::Result;
+
+    for (const WindowActionOutcome &outcome : report.outcomes) {
+        if (outcome.result == Result::Done) continue;
+
+        const char *result = outcome.result == Result::Escalated  ? "hidden instead"
+                           : outcome.result == Result::Gone       ? "closed"
+                           : outcome.result == Result::Superseded ? "taken over by a later hotkey"
+                                                                  : "not responding";
+        qDebug().nospace() << "Window 0x" << Qt::hex << outcome.window << Qt::dec << ": " << result
+                           << " after " << outcome.attempts << " attempts, "
+                           << outcome.elapsed.count() << " us";
+    }
+
+    qDebug() << "Window action finished:"
+             << report.count(Result::Done) << "done,"
+             << report.count(Result::Escalated) << "hidden,"
+             << report.count(Result::TimedOut) << "not responding,"
+             << report.count(Result::Gone) << "closed,"
+             << report.count(Result::Superseded) << "superseded in"
+             << report.elapsed.count() << "us";
+}
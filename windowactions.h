@@ -0,0 +1,22 @@
+#ifndef WINDOWACTIONS_H
+#define WINDOWACTIONS_H
+
+#include <QStringList>
+#include "platformbackend.h"
+#include "windowactiondispatcher.h"
+
+// What a minimize/restore hotkey does, shared by the GUI and headless apps.
+// Finds the named processes in the published snapshot, re-reads the current
+// windows of just those (none at all if no target is running) and dispatches
+// action to them. A target started after the last refresh is missed until
+// the next one. Snapshots skip hidden windows, so a restore also covers
+// every window the dispatcher has hidden.
+void dispatchToProcessWindows(const ProcessSnapshotPublisher &snapshots, PlatformBackend &backend,
+                              WindowActionDispatcher &dispatcher,
+                              const QStringList &processNames, WindowAction action,
+                              WindowActionDispatcher::Callback onFinished);
+
+// qDebug line for each window that didn't simply succeed, then a summary
+void traceWindowActionReport(const WindowActionReport &report);
+
+#endif // WINDOWACTIONS_H
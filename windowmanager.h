@@ -0,0 +1,33 @@
+#ifndef WINDOWMANAGER_H
+#define WINDOWMANAGER_H
+
+#include "processsnapshot.h"
+
+enum class WindowAction {
+    Minimize,
+    Restore,
+    Hide,
+};
+
+enum class WindowState {
+    Normal,
+    Minimized,
+    Hidden,
+    Gone, // Destroyed, or never existed
+};
+
+// The part of the OS that moves windows around. Implementations must be
+// callable from any thread and must never block on the target window:
+// a hung window may ignore actions, but it can't stall the caller.
+class WindowManager {
+public:
+    virtual ~WindowManager() = default;
+
+    // Fire and forget; does not wait for the window to respond
+    virtual void applyWindowAction(ProcessSnapshot::WindowHandle window, WindowAction action) = 0;
+    virtual WindowState windowState(ProcessSnapshot::WindowHandle window) = 0;
+    // False while the window's thread isn't processing messages (hung)
+    virtual bool isResponding(ProcessSnapshot::WindowHandle window) = 0;
+};
+
+#endif // WINDOWMANAGER_H